@@ -3,85 +3,448 @@
 #include <chrono>
 #include <vector>
 #include <limits>
+#include <algorithm>
+#include <cstdint>
+#include <complex>
+#include <cmath>
+#if defined(LABS_KERNEL_SIMD)
+#include <immintrin.h>
+#endif
+// Jedri simd in scalar berejo zaporedje po elementih iz s8, popcount pa le pakirano.
+#if defined(LABS_KERNEL_SIMD) || defined(LABS_KERNEL_SCALAR)
+#define LABS_UNPACKED 1
+#else
+#define LABS_UNPACKED 0
+#endif
+// LABSBatch pri jedru simd racuna vse pasove hkrati iz kopije v razporeditvi SoA.
+#if defined(LABS_KERNEL_SIMD)
+#define LABS_BATCH_SOA 1
+#else
+#define LABS_BATCH_SOA 0
+#endif
 
 using namespace std;
 using namespace std::chrono;
 
+// Od te dolzine naprej evaluate_* racuna c[k] s FFT v O(L log L) namesto
+// neposredno v O(L^2), nakljucno iskanje pa ne ocenjuje vec po skupinah LABSBatch.
+// Izmerjeno s tem programom (Release, jedro popcount) kot primerjava eval/sec za E
+// pri -DLABS_FFT_CROSSOVER=0 in 32769; za PSL je skupina hitrejsa se dlje.
+#ifndef LABS_FFT_CROSSOVER
+#define LABS_FFT_CROSSOVER 7500
+#endif
+// LABSBatch hrani c[k] v int16, zato sprejme najvec L = 32768.
+static_assert(LABS_FFT_CROSSOVER <= 32769, "LABS_FFT_CROSSOVER above 32769 would batch sequences longer than LABSBatch allows");
+
+// xoshiro256** (Blackman in Vigna), stanje inicializiramo s splitmix64.
+// Bistveno hitrejsi od mt19937 in vrne 64 bitov na klic.
+class xoshiro256ss{
+public:
+    typedef uint64_t result_type;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return numeric_limits<uint64_t>::max(); }
+    explicit xoshiro256ss(uint64_t seed){ for(size_t j=0; j<4; j++) s[j] = splitmix64(seed); }
+    inline result_type operator()(){
+        const uint64_t r = rotl(s[1]*5, 7)*9, t = s[1]<<17;
+        s[2] ^= s[0]; s[3] ^= s[1]; s[1] ^= s[2]; s[0] ^= s[3];
+        s[2] ^= t; s[3] = rotl(s[3], 45);
+        return r;
+    }
+
+private:
+    static inline uint64_t rotl(const uint64_t x, const int k){ return (x<<k) | (x>>(64-k)); }
+    static uint64_t splitmix64(uint64_t & x){
+        uint64_t z = (x += 0x9e3779b97f4a7c15);
+        z = (z^(z>>30))*0xbf58476d1ce4e5b9;
+        z = (z^(z>>27))*0x94d049bb133111eb;
+        return z^(z>>31);
+    }
+    uint64_t s[4];
+};
+
+// Generator, ki ga uporabljajo iskanja; izberemo ga z LABS_RNG v CMake.
+#if defined(LABS_RNG_MT19937)
+typedef mt19937 Rng;
+#else
+typedef xoshiro256ss Rng;
+#endif
+
+// 64 nakljucnih bitov iz enega klica 64-bitnega ali dveh klicev 32-bitnega generatorja
+template<class RNG>
+inline uint64_t bits64(RNG & rand){
+    static_assert(RNG::min() == 0 && (RNG::max() == 0xffffffffu || RNG::max() == numeric_limits<uint64_t>::max()),
+                  "RNG must return 32 or 64 random bits");
+    if(RNG::max() == numeric_limits<uint64_t>::max()) return rand();
+    const uint64_t hi = rand();
+    return (hi<<32) | uint64_t(rand());
+}
+
+// Iterativna radix-2 FFT na mestu, a.size() mora biti potenca 2.
+// Inverzna transformacija ne deli z a.size().
+void fft(vector<complex<double>> & a, const bool inverse){
+    const size_t N = a.size();
+    static thread_local vector<complex<double>> w;
+    if(w.size() != N/2){
+        w.resize(N/2);
+        for(size_t j=0; j<N/2; j++) w[j] = polar(1.0, -2*M_PI*j/N);
+    }
+    for(size_t i=1, j=0; i<N; i++){
+        size_t bit = N>>1;
+        for(; j&bit; bit>>=1) j ^= bit;
+        j ^= bit;
+        if(i < j) swap(a[i], a[j]);
+    }
+    for(size_t len=2; len<=N; len<<=1){
+        const size_t step = N/len;
+        for(size_t i=0; i<N; i+=len){
+            for(size_t j=0; j<len/2; j++){
+                // mnozimo rocno, operator* preverja se NaN/Inf in je bistveno pocasnejsi
+                const double wr = w[j*step].real(), wi = inverse ? -w[j*step].imag() : w[j*step].imag();
+                const double xr = a[i+j+len/2].real(), xi = a[i+j+len/2].imag();
+                const complex<double> t(wr*xr - wi*xi, wr*xi + wi*xr);
+                a[i+j+len/2] = a[i+j] - t;
+                a[i+j] += t;
+            }
+        }
+    }
+}
+
+// Skew-simetricno zaporedje lihe dolzine L=2m-1 ima s[m-1+j] = (-1)^j s[m-1-j].
+// Vsi lihi c[k] so 0, zato jih pri neposrednem izracunu ne racunamo.
 class LABS{
 public:
     enum value { p=+1, n=-1};
-    LABS(const size_t L): L(L), seq(L,p), c(L,0),
-          e(numeric_limits<int>::max()), psl(numeric_limits<int>::max()) {};
-    LABS(const LABS & l): L(l.L), seq(l.seq), c(l.c), e(l.e), psl(l.psl) {}
+    // Zaporedje je pakirano po 64 elementov v besedo: bit 1 pomeni n, bit 0 pomeni p.
+    // Zadnja beseda je vedno 0, da lahko correlation() bere eno besedo cez konec.
+    LABS(const size_t L, const bool skew=false): L(L), skew(skew), seq((L+63)/64+1,0), s8(LABS_UNPACKED ? L : 0,0), c(L,0),
+          e(numeric_limits<int64_t>::max()), psl(numeric_limits<int>::max()) {
+        if(skew && L%2 == 0) throw string("Skew-symmetric sequences need odd length!");
+    };
+    LABS(const LABS & l): L(l.L), skew(l.skew), seq(l.seq), s8(l.s8), c(l.c), e(l.e), psl(l.psl) {}
     LABS& operator=(const LABS & l);
     inline double get_mf() const { return (L*L)/(2.0*e); }
-    inline int get_e() const { return e; }
+    inline int64_t get_e() const { return e; }
     inline int get_psl() const { return psl; }
-    void random(mt19937 & rand);
+    inline value operator[](const size_t i) const { return (seq[i/64]>>(i%64))&1 ? n : p; }
+    inline void set(const size_t i, const value v){
+        if(v == n) seq[i/64] |= uint64_t(1)<<(i%64);
+        else seq[i/64] &= ~(uint64_t(1)<<(i%64));
+    }
+    template<class RNG> void random(RNG & rand);
     void evaluate_e();
     void evaluate_psl();
-    static LABS random_search_e(const size_t seed, const size_t n, const size_t L);
-    static LABS random_search_psl(const size_t seed, const size_t n, const size_t L);
+    static LABS random_search_e(const size_t seed, const size_t n, const size_t L, const bool skew=false);
+    static LABS random_search_psl(const size_t seed, const size_t n, const size_t L, const bool skew=false);
 
 private:
+    friend class LABSBatch;
+    void mirror();
+    void unpack();
+    int correlation(const size_t k) const;
+    void correlate();
     const size_t L;
-    vector<value> seq;
+    bool skew;
+    vector<uint64_t> seq;
+    vector<int8_t> s8; // kopija zaporedja po elementih za jedri simd in scalar, sicer prazna
     vector<int> c;
-    int e, psl;
+    int64_t e; // pri L nad ~65000 E preseze int
+    int psl;
 };
 
 LABS& LABS::operator=(const LABS & l){
     if(L != l.L) throw std::string("Sequences with diferent length!");
-    seq=l.seq; c=l.c; e=l.e; psl=l.psl; return *this;
+    skew=l.skew; seq=l.seq; c=l.c; e=l.e; psl=l.psl; return *this;
 }
 
-void LABS::random(mt19937 & rand){
-    for(size_t i=0; i<L; i++){
-        if(rand()%2) seq[i] = p;
-        else seq[i] = n;
+// Vsaka beseda dobi 64 bitov generatorja naenkrat, biti za L v zadnji besedi so 0.
+template<class RNG>
+void LABS::random(RNG & rand){
+    const size_t W = (L+63)/64;
+    for(size_t j=0; j<W; j++) seq[j] = bits64(rand);
+    if(L%64) seq[W-1] &= (uint64_t(1)<<(L%64))-1;
+    mirror();
+}
+
+// Pri skew-simetricnem zaporedju iz prvih (L+1)/2 elementov dopolni zrcalne.
+void LABS::mirror(){
+    if(!skew) return;
+    const size_t m = (L+1)/2;
+    for(size_t i=0; i+1<m; i++) set(L-1-i, (m-1-i)%2 ? (value)(-(*this)[i]) : (*this)[i]);
+}
+
+void LABS::unpack(){
+#if LABS_UNPACKED
+    for(size_t i=0; i<L; i++) s8[i] = (*this)[i];
+#endif
+}
+
+#if defined(LABS_KERNEL_SIMD)
+// c[k] iz kopije int8: enake pare prestejemo s primerjavo 32/64 elementov hkrati
+// in popcount maske, c[k] = 2*enakih - (L-k).
+int LABS::correlation(const size_t k) const{
+    const int8_t *a = s8.data(), *b = s8.data()+k;
+    const size_t m = L-k;
+    size_t i = 0;
+    int eq = 0;
+#if defined(__AVX512BW__)
+    for (; i+64<=m; i+=64) {
+        const __m512i x = _mm512_loadu_si512(a+i), y = _mm512_loadu_si512(b+i);
+        eq += __builtin_popcountll(_mm512_cmpeq_epi8_mask(x,y));
+    }
+    if (i<m) {
+        const __mmask64 mask = (uint64_t(1)<<(m-i))-1;
+        const __m512i x = _mm512_maskz_loadu_epi8(mask,a+i), y = _mm512_maskz_loadu_epi8(mask,b+i);
+        eq += __builtin_popcountll(_mm512_mask_cmpeq_epi8_mask(mask,x,y));
+    }
+    return 2*eq - (int)m;
+#elif defined(__AVX2__)
+    for (; i+32<=m; i+=32) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a+i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(b+i));
+        eq += __builtin_popcount(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x,y)));
+    }
+    int ck = 2*eq - (int)i;
+    for (; i<m; i++) ck += a[i]*b[i];
+    return ck;
+#else
+    int ck = 0;
+    for (; i<m; i++) ck += a[i]*b[i];
+    return ck;
+#endif
+}
+#elif defined(LABS_KERNEL_SCALAR)
+// Referencna izvedba
+int LABS::correlation(const size_t k) const{
+    int ck = 0;
+    for (size_t i=0; i<=L-k-1; i++) ck += s8[i]*s8[i+k];
+    return ck;
+}
+#else
+// c[k] = (L-k) - 2*(stevilo razlicnih parov s[i], s[i+k]).
+// Razlicne pare prestejemo z XOR besede in za k zamaknjene besede ter popcount.
+int LABS::correlation(const size_t k) const{
+    const size_t q = k/64, r = k%64, m = L-k;
+    const size_t full = m/64;
+    int d = 0;
+    size_t j = 0;
+    for (; j<full; j++) {
+        // (x<<1)<<(63-r) namesto x<<(64-r), ker je zamik za 64 nedefiniran
+        const uint64_t w = (seq[j+q]>>r) | ((seq[j+q+1]<<1)<<(63-r));
+        d += __builtin_popcountll(seq[j]^w);
+    }
+    if (m%64) {
+        const uint64_t w = (seq[j+q]>>r) | ((seq[j+q+1]<<1)<<(63-r));
+        d += __builtin_popcountll((seq[j]^w) & ((uint64_t(1)<<(m%64))-1));
+    }
+    return (int)m - 2*d;
+}
+#endif
+
+// Izracuna vse c[k]; nad LABS_FFT_CROSSOVER kot IFFT(|FFT(s)|^2), kjer je
+// s dopolnjen z niclami do vsaj 2L, da se ciklicna korelacija ne prekriva.
+void LABS::correlate(){
+    if(L < LABS_FFT_CROSSOVER){
+        const size_t step = skew ? 2 : 1;
+        unpack();
+        for (size_t k=1; k<L; k++) c[k] = 0;
+        for (size_t k=step; k<L; k+=step) c[k] = correlation(k);
+        return;
     }
+    size_t N = 1;
+    while(N < 2*L) N <<= 1;
+    vector<complex<double>> a(N);
+    for (size_t i=0; i<L; i++) a[i] = (*this)[i];
+    fft(a, false);
+    for (size_t j=0; j<N; j++) a[j] = norm(a[j]);
+    fft(a, true);
+    for (size_t k=1; k<L; k++) c[k] = (int)lround(a[k].real()/N);
 }
 
 void LABS::evaluate_e(){
+    correlate();
     e = 0;
+    for (size_t k=1; k<L; k++) e += (int64_t)c[k]*c[k];
+    #ifndef NDEBUG
+    int64_t evaluate_e = 0;
     for (size_t k=1; k<L; k++) {
-        c[k]=0;
-        for (size_t i=0; i<=L-k-1; i++) c[k] += seq[i]*seq[i+k];
-        e += c[k]*c[k];
+        int ck = 0;
+        for (size_t i=0; i<=L-k-1; i++) ck += (*this)[i]*(*this)[i+k];
+        evaluate_e += (int64_t)ck*ck;
     }
+    if(e != evaluate_e) throw string("Wrong E!");
+    #endif
 }
 
 void LABS::evaluate_psl(){
+    correlate();
     psl = 0;
     for (size_t k=1; k<L; k++) {
-        c[k]=0;
-        for (size_t i=0; i<=L-k-1; i++) c[k] += seq[i]*seq[i+k];
         if(abs(c[k]) > psl) psl = abs(c[k]);
     }
 }
 
-LABS LABS::random_search_e(const size_t seed, const size_t n, const size_t L){
-    LABS current(L), best(L);
-    mt19937 rand(seed);
+// Skupina B zaporedij, ki jih ocenimo skupaj: za vsak k izracunamo c[k] vseh pasov
+// in prekinemo, ko so vsi slabsi od meje. Jedro izberemo z LABS_KERNEL. Pri simd so
+// zaporedja v razporeditvi SoA (s[i*B+b] je i-ti element zaporedja b), zato notranje
+// zanke tecejo po pasovih in se vektorizirajo; popcount in scalar klicemo za vsak pas.
+class LABSBatch{
+public:
+    static const size_t B = 32;
+    LABSBatch(const size_t L, const bool skew): L(L), step(skew ? 2 : 1), lanes(B,LABS(L,skew)), s(LABS_BATCH_SOA ? L*B : 0,0),
+          e(B,0), psl(B,0) {
+        if(L > 32768) throw string("Sequence too long for LABSBatch!");
+    }
+    inline int64_t get_e(const size_t b) const { return e[b]; }
+    inline int get_psl(const size_t b) const { return psl[b]; }
+    template<class RNG> void random(RNG & rand);
+    void get(const size_t b, LABS & l) const { l = lanes[b]; }
+    bool evaluate_e_bounded(const int64_t limit, const size_t m);
+    bool evaluate_psl_bounded(const int limit, const size_t m);
+    size_t argmin_e(const size_t m) const;
+    size_t argmin_psl(const size_t m) const;
+
+private:
+    void correlation(const size_t k, int16_t ck[]) const;
+    const size_t L, step; // step 2 v skew nacinu, kjer so lihi c[k] 0
+    vector<LABS> lanes;
+    vector<int8_t> s; // kopija pasov v razporeditvi SoA za jedro simd, sicer prazna
+    vector<int64_t> e;
+    vector<int> psl;
+};
+
+const size_t LABSBatch::B;
+
+// Pasove napolni LABS::random (pakirano); simd in scalar potrebujeta se kopijo po elementih.
+template<class RNG>
+void LABSBatch::random(RNG & rand){
+    for(size_t b=0; b<B; b++){
+        lanes[b].random(rand);
+        lanes[b].unpack();
+    }
+#if LABS_BATCH_SOA
+    for(size_t i=0; i<L; i++){
+        for(size_t b=0; b<B; b++) s[i*B+b] = lanes[b][i];
+    }
+#endif
+}
+
+#if LABS_BATCH_SOA
+// c[k] za vse pasove. Za +-1 v int8 je x^y enako 0 ali -2, zato je
+// c[k] = (L-k) + sum x^y. Vsoto zbiramo v int8 po 64 clenov (najmanj -128),
+// nato jo prisejemo v int16 (|c[k]| < L <= 32768).
+void LABSBatch::correlation(const size_t k, int16_t ck[]) const{
+    const int8_t *x = s.data(), *y = s.data()+k*B;
+    int8_t c8[B];
+    for(size_t b=0; b<B; b++) ck[b] = (int16_t)(L-k);
+    for(size_t i0=0; i0<L-k; i0+=64){
+        const size_t i1 = min(L-k, i0+64);
+        for(size_t b=0; b<B; b++) c8[b] = 0;
+        for(size_t i=i0; i<i1; i++){
+            for(size_t b=0; b<B; b++) c8[b] += x[i*B+b]^y[i*B+b];
+        }
+        for(size_t b=0; b<B; b++) ck[b] += c8[b];
+    }
+}
+#else
+void LABSBatch::correlation(const size_t k, int16_t ck[]) const{
+    for(size_t b=0; b<B; b++) ck[b] = (int16_t)lanes[b].correlation(k);
+}
+#endif
+
+// Oceni prvih m pasov. Konca, ko delna E vseh m pasov doseze limit, in takrat
+// vrne false; sicer so vse E natancne in vrne true.
+bool LABSBatch::evaluate_e_bounded(const int64_t limit, const size_t m){
+    int16_t ck[B];
+    fill(e.begin(), e.end(), 0);
+    for(size_t k=step; k<L; k+=step){
+        correlation(k, ck);
+        for(size_t b=0; b<B; b++) e[b] += ck[b]*ck[b];
+        if(*min_element(e.begin(), e.begin()+m) >= limit) return false;
+    }
+    #ifndef NDEBUG
+    LABS l(L, step == 2);
+    for(size_t b=0; b<B; b++){
+        get(b, l);
+        l.evaluate_e();
+        if(l.get_e() != e[b]) throw string("Wrong batch E!");
+    }
+    #endif
+    return true;
+}
+
+bool LABSBatch::evaluate_psl_bounded(const int limit, const size_t m){
+    int16_t ck[B];
+    fill(psl.begin(), psl.end(), 0);
+    for(size_t k=step; k<L; k+=step){
+        correlation(k, ck);
+        for(size_t b=0; b<B; b++) psl[b] = max(psl[b], (int)abs(ck[b]));
+        if(*min_element(psl.begin(), psl.begin()+m) >= limit) return false;
+    }
+    return true;
+}
+
+// Prvi pas z najmanjso vrednostjo med prvimi m pasovi
+size_t LABSBatch::argmin_e(const size_t m) const{
+    return min_element(e.begin(), e.begin()+m) - e.begin();
+}
+
+size_t LABSBatch::argmin_psl(const size_t m) const{
+    return min_element(psl.begin(), psl.begin()+m) - psl.begin();
+}
+
+LABS LABS::random_search_e(const size_t seed, const size_t n, const size_t L, const bool skew){
+    LABS current(L,skew), best(L,skew);
+    Rng rand(seed);
     best.random(rand);
     best.evaluate_e();
-    for(size_t i=0; i<n; i++){
-        current.random(rand);
-        current.evaluate_e();
-        if(current.get_e() < best.get_e()) best = current;
+    // Nad LABS_FFT_CROSSOVER ocena s FFT nima delnih vsot, zato oceni vse
+    if(L >= LABS_FFT_CROSSOVER){
+        for(size_t i=0; i<n; i++){
+            current.random(rand);
+            current.evaluate_e();
+            if(current.get_e() < best.get_e()) best = current;
+        }
+        return best;
+    }
+    // Kandidate ocenjujemo po B hkrati in prekinemo, ko so vsi slabsi od best;
+    // natancno oceni le sprejetega
+    LABSBatch batch(L,skew);
+    for(size_t i=0; i<n; i+=LABSBatch::B){
+        const size_t m = min(LABSBatch::B, n-i);
+        batch.random(rand);
+        if(!batch.evaluate_e_bounded(best.get_e(), m)) continue;
+        const size_t b = batch.argmin_e(m);
+        if(batch.get_e(b) < best.get_e()){
+            batch.get(b, best);
+            best.evaluate_e();
+        }
     }
     return best;
 }
 
-LABS LABS::random_search_psl(const size_t seed, const size_t n, const size_t L){
-    LABS current(L), best(L);
-    mt19937 rand(seed);
+LABS LABS::random_search_psl(const size_t seed, const size_t n, const size_t L, const bool skew){
+    LABS current(L,skew), best(L,skew);
+    Rng rand(seed);
     best.random(rand);
     best.evaluate_psl();
-    for(size_t i=0; i<n; i++){
-        current.random(rand);
-        current.evaluate_psl();
-        if(current.get_psl() < best.get_psl()) best = current;
+    if(L >= LABS_FFT_CROSSOVER){
+        for(size_t i=0; i<n; i++){
+            current.random(rand);
+            current.evaluate_psl();
+            if(current.get_psl() < best.get_psl()) best = current;
+        }
+        return best;
+    }
+    LABSBatch batch(L,skew);
+    for(size_t i=0; i<n; i+=LABSBatch::B){
+        const size_t m = min(LABSBatch::B, n-i);
+        batch.random(rand);
+        if(!batch.evaluate_psl_bounded(best.get_psl(), m)) continue;
+        const size_t b = batch.argmin_psl(m);
+        if(batch.get_psl(b) < best.get_psl()){
+            batch.get(b, best);
+            best.evaluate_psl();
+        }
     }
     return best;
 }
@@ -91,9 +454,15 @@ int main(int argc, char *argv[]){
         if(argc < 4) throw string("Three arguments are required!");
 
         const size_t seed =atoi(argv[1]), n = atoi(argv[2]), D = atoi(argv[3]);
+        // Neobvezen cetrti argument "skew" omeji iskanje na skew-simetricna zaporedja
+        bool skew = false;
+        if(argc > 4){
+            if(string(argv[4]) != "skew") throw string("Unknown argument ")+argv[4]+"!";
+            skew = true;
+        }
         cout<<"Searching ..."<<endl;
         auto start = system_clock::now();
-        LABS best = LABS::random_search_e(seed,n,D);
+        LABS best = LABS::random_search_e(seed,n,D,skew);
         auto end = system_clock::now();
         auto elapsed = duration_cast<milliseconds>(end - start);
         cout<<"E: "<<best.get_e()<<" F: "<<best.get_mf();
@@ -101,7 +470,7 @@ int main(int argc, char *argv[]){
 
         cout<<"Searching ..."<<endl;
         start = system_clock::now();
-        best = LABS::random_search_psl(seed,n,D);
+        best = LABS::random_search_psl(seed,n,D,skew);
         end = system_clock::now();
         elapsed = duration_cast<milliseconds>(end - start);
         cout<<"PSL: "<<best.get_psl();
@@ -3,32 +3,89 @@
 #include <chrono>
 #include <vector>
 #include <limits>
+#include <cstdint>
+#include <algorithm>
 
 using namespace std;
 using namespace std::chrono;
 
+// Politika ponovnih zagonov. fixed zacne znova vsakih unit korakov, luby po
+// unit*luby(r) korakih, geometric po unit*1.5^r korakih (r je stevilo dosedanjih
+// zagonov), stagnation pa po unit korakih brez izboljsave v trenutnem zagonu.
+// perturb>0 pomeni delni zagon: namesto novega nakljucnega zaporedja zamenjamo
+// perturb nakljucnih elementov najboljse resitve, c[] pa popravimo inkrementalno.
+class Restart{
+public:
+    enum policy { fixed, luby, geometric, stagnation };
+    Restart(const policy type, const size_t unit, const size_t perturb):
+        type(type), unit(unit), perturb(perturb), restarts(0), steps(0), lmt(unit) {}
+    // Klicemo po vsakem koraku; vrne true, ko je cas za ponovni zagon.
+    bool step(const bool improved){
+        if(type == stagnation && improved) steps = 0;
+        if(++steps < lmt) return false;
+        steps = 0;
+        restarts++;
+        if(type == luby) lmt = unit*luby_seq(restarts+1);
+        else if(type == geometric) lmt = lmt + lmt/2;
+        return true;
+    }
+    inline size_t get_perturb() const { return perturb; }
+    static size_t luby_seq(const size_t i); // 1 1 2 1 1 2 4 1 1 2 ...
+
+private:
+    const policy type;
+    const size_t unit, perturb;
+    size_t restarts, steps, lmt;
+};
+
+size_t Restart::luby_seq(const size_t i){
+    size_t k = 1;
+    while(((size_t)1<<k)-1 < i) k++;
+    if(i == ((size_t)1<<k)-1) return (size_t)1<<(k-1);
+    return luby_seq(i - ((size_t)1<<(k-1)) + 1);
+}
+
+// Skew-simetricno zaporedje lihe dolzine L=2m-1 ima s[m-1+j] = (-1)^j s[m-1-j].
+// Vsi lihi c[k] so 0, zato racunamo le sode zamike. Prostih elementov je m, poteza
+// i < m-1 zamenja s[i] in zrcalni s[L-1-i] hkrati, poteza m-1 pa sredinski element.
 class LABS{
 public:
     enum value { p=+1, n=-1};
-    LABS(const size_t L): L(L), seq(L,p), c(L,0),
-          e(numeric_limits<int>::max()), psl(numeric_limits<int>::max()) {};
-    LABS(const LABS & l): L(l.L), seq(l.seq), c(l.c), e(l.e), psl(l.psl) {}
+    LABS(const size_t L, const bool skew=false): L(L), skew(skew), seq(L,p), c(L,0),
+          e(numeric_limits<int>::max()), psl(numeric_limits<int>::max()) {
+        if(skew && L%2 == 0) throw string("Skew-symmetric sequences need odd length!");
+    };
+    LABS(const LABS & l): L(l.L), skew(l.skew), seq(l.seq), c(l.c), e(l.e), psl(l.psl) {}
     LABS& operator=(const LABS & l);
     inline double get_mf() const { return (L*L)/(2.0*e); }
     inline int get_e() const { return e; }
     inline int get_psl() const { return psl; }
+    inline size_t moves() const { return skew ? (L+1)/2 : L; }
     void random(mt19937 & rand);
+    void perturb_e(const size_t k, mt19937 & rand);
+    void perturb_psl(const size_t k, mt19937 & rand);
     void evaluate_e();
     void evaluate_psl();
     int neighbor_e(const size_t n) const;
     int neighbor_psl(const size_t n) const;
+    int neighbor2_e(const size_t i, const size_t j) const;
+    int neighbor2_psl(const size_t i, const size_t j) const;
     void update_e(const size_t n, const int e);
     void update_psl(const size_t n, const int psl);
-    static LABS neighborhood_search_e(const size_t seed, const size_t n, const size_t L);
-    static LABS neighborhood_search_psl(const size_t seed, const size_t n, const size_t L);
+    void update2_e(const size_t i, const size_t j, const int e);
+    void update2_psl(const size_t i, const size_t j, const int psl);
+    static LABS neighborhood_search_e(const size_t seed, const size_t n, const size_t L, const size_t samples,
+                                      const bool skew, const Restart & restart);
+    static LABS neighborhood_search_psl(const size_t seed, const size_t n, const size_t L, const size_t samples,
+                                        const bool skew, const Restart & restart);
 
 private:
+    size_t pair_flips(const size_t i, const size_t j, size_t f[]) const;
+    int flips_c(const size_t f[], const size_t m, const size_t k) const;
+    int skew_delta(const size_t i, const size_t k) const;
+    void check_skew() const;
     const size_t L;
+    bool skew;
     vector<value> seq;
     vector<int> c;
     int e, psl;
@@ -36,39 +93,96 @@ private:
 
 LABS& LABS::operator=(const LABS & l){
     if(L != l.L) throw std::string("Sequences with diferent length!");
-    seq=l.seq; c=l.c; e=l.e; psl=l.psl; return *this;
+    skew=l.skew; seq=l.seq; c=l.c; e=l.e; psl=l.psl; return *this;
 }
 
 void LABS::random(mt19937 & rand){
-    for(size_t i=0; i<L; i++){
-        if(rand()%2) seq[i] = p;
-        else seq[i] = n;
+    // En klic generatorja da 32 nakljucnih elementov.
+    for(size_t i=0; i<moves(); i+=32){
+        const uint32_t w = rand();
+        for(size_t j=i; j<min(moves(), i+32); j++) seq[j] = (w>>(j-i))&1 ? p : n;
+    }
+    if(skew){
+        const size_t m = moves();
+        for(size_t i=0; i+1<m; i++) seq[L-1-i] = (m-1-i)%2 ? (value)(-seq[i]) : seq[i];
+    }
+}
+
+// Delni zagon: k nakljucnih zamenjav, vsaka stane O(L) namesto O(L^2) za evaluate_e.
+void LABS::perturb_e(const size_t k, mt19937 & rand){
+    for(size_t t=0; t<k; t++){
+        const size_t i = rand()%moves();
+        update_e(i, neighbor_e(i));
+    }
+}
+
+void LABS::perturb_psl(const size_t k, mt19937 & rand){
+    for(size_t t=0; t<k; t++){
+        const size_t i = rand()%moves();
+        update_psl(i, neighbor_psl(i));
     }
 }
 
 void LABS::evaluate_e(){
+    const size_t step = skew ? 2 : 1;
     e = 0;
-    for (size_t k=1; k<L; k++) {
-        c[k]=0;
+    for (size_t k=1; k<L; k++) c[k]=0;
+    for (size_t k=step; k<L; k+=step) {
         for (size_t i=0; i<=L-k-1; i++) c[k] += seq[i]*seq[i+k];
         e += c[k]*c[k];
     }
+    #ifndef NDEBUG
+    check_skew();
+    #endif
 }
 
 void LABS::evaluate_psl(){
+    const size_t step = skew ? 2 : 1;
     psl = 0;
-    for (size_t k=1; k<L; k++) {
-        c[k]=0;
+    for (size_t k=1; k<L; k++) c[k]=0;
+    for (size_t k=step; k<L; k+=step) {
         for (size_t i=0; i<=L-k-1; i++) c[k] += seq[i]*seq[i+k];
         if(abs(c[k]) > psl) psl = abs(c[k]);
     }
+    #ifndef NDEBUG
+    check_skew();
+    #endif
+}
+
+// Preveri, da so lihi c[k] res 0, ker jih skew-simetricne funkcije ne racunajo.
+void LABS::check_skew() const{
+    if(!skew) return;
+    for (size_t k=1; k<L; k+=2){
+        int ck = 0;
+        for (size_t i=0; i<=L-k-1; i++) ck += seq[i]*seq[i+k];
+        if(ck) throw string("Sequence is not skew-symmetric!");
+    }
+}
+
+// Za koliko se zmanjsa c[k]/2 (k sod), ce hkrati zamenjamo s[i] in zrcalni s[m], m = L-1-i.
+// Pri sodem k je s[m]*(s[m+k] + s[m-k]) = s[i]*(s[i-k] + s[i+k]), zato zrcalni element
+// le podvoji prispevek s[i]. Produkt s[i]*s[m] pri k = m-i ostane enak.
+int LABS::skew_delta(const size_t i, const size_t k) const{
+    const size_t m = L-1-i;
+    int d = 0;
+    if(i+k<L) d += seq[i]*seq[k+i];
+    if(k<=i) d += seq[i-k]*seq[i];
+    if(m != i){
+        d *= 2;
+        if(k == m-i) d -= 2*seq[i]*seq[m];
+    }
+    return d;
 }
 
 int LABS::neighbor_e(const size_t i) const{
     int e = 0, ck;
     const size_t lmt = std::max(L-i,i+1);
     size_t k=1;
-    for(;k<lmt; k++) {
+    if(skew) for(k=2; k<lmt; k+=2){
+        ck = c[k] - 2*skew_delta(i,k);
+        e += ck*ck;
+    }
+    else for(;k<lmt; k++) {
         ck = c[k];
         if(i+k<L) ck -= 2*seq[i]*seq[k+i];
         if(k<=i) ck -= 2*seq[i-k]*seq[i];
@@ -82,22 +196,74 @@ int LABS::neighbor_psl(const size_t i) const{
     int psl = 0, ck;
     const size_t lmt = max(L-i,i+1);
     size_t k=1;
-    for(; k<lmt; k++) {
+    if(skew) for(k=2; k<lmt; k+=2){
+        ck = c[k] - 2*skew_delta(i,k);
+        if(abs(ck) > psl) psl = abs(ck);
+    }
+    else for(; k<lmt; k++) {
         ck = c[k];
         if(i+k<L) ck -= 2*seq[i]*seq[k+i];
         if(k<=i) ck -= 2*seq[i-k]*seq[i];
         if(abs(ck) > psl) psl = abs(ck);
     }
-    for (size_t k=1; k<L; k++){
+    for (; k<L; k++){
         if(abs(c[k]) > psl) psl = abs(c[k]);
     }
     return psl;
 }
 
+// Elementi, ki jih zamenja par potez i != j; v skew nacinu se zrcalna, skupaj najvec 4.
+size_t LABS::pair_flips(const size_t i, const size_t j, size_t f[]) const{
+    size_t m = 0;
+    f[m++] = i;
+    f[m++] = j;
+    if(skew && L-1-i != i) f[m++] = L-1-i;
+    if(skew && L-1-j != j) f[m++] = L-1-j;
+    return m;
+}
+
+// c[k] po hkratni zamenjavi razlicnih elementov f[0..m). Produkt dveh zamenjanih
+// elementov pri k = razdalji med njima odstejeta oba clena, ostati pa mora enak,
+// zato ga pristejemo nazaj.
+int LABS::flips_c(const size_t f[], const size_t m, const size_t k) const{
+    int ck = c[k];
+    for(size_t a=0; a<m; a++){
+        const size_t x = f[a];
+        if(x+k<L) ck -= 2*seq[x]*seq[k+x];
+        if(k<=x) ck -= 2*seq[x-k]*seq[x];
+    }
+    for(size_t a=0; a<m; a++){
+        for(size_t b=a+1; b<m; b++){
+            if(k == (f[a]<f[b] ? f[b]-f[a] : f[a]-f[b])) ck += 4*seq[f[a]]*seq[f[b]];
+        }
+    }
+    return ck;
+}
+
+int LABS::neighbor2_e(const size_t i, const size_t j) const{
+    size_t f[4];
+    const size_t m = pair_flips(i,j,f), step = skew ? 2 : 1;
+    int e = 0, ck;
+    for(size_t k=step; k<L; k+=step){
+        ck = flips_c(f,m,k);
+        e += ck*ck;
+    }
+    return e;
+}
+
+int LABS::neighbor2_psl(const size_t i, const size_t j) const{
+    size_t f[4];
+    const size_t m = pair_flips(i,j,f), step = skew ? 2 : 1;
+    int psl = 0;
+    for(size_t k=step; k<L; k+=step) psl = max(psl, abs(flips_c(f,m,k)));
+    return psl;
+}
+
 void LABS::update_e(const size_t i, const int e){
     const size_t lmt = max(L-i,i+1);
     size_t k=1;
-    for (;k<lmt; k++){
+    if(skew) for (k=2; k<lmt; k+=2) c[k] -= 2*skew_delta(i,k);
+    else for (;k<lmt; k++){
         int ck = c[k];
         if(i+k<L) ck -= 2*seq[i]*seq[k+i];
         if(k<=i) ck -= 2*seq[i-k]*seq[i];
@@ -105,6 +271,20 @@ void LABS::update_e(const size_t i, const int e){
     }
     this->e = e;
     seq[i] = (value)(-seq[i]);
+    if(skew && L-1-i != i) seq[L-1-i] = (value)(-seq[L-1-i]);
+    #ifndef NDEBUG
+    int update_e = e;
+    evaluate_e();
+    if(e != update_e) throw string("Wrong E!");
+    #endif
+}
+
+void LABS::update2_e(const size_t i, const size_t j, const int e){
+    size_t f[4];
+    const size_t m = pair_flips(i,j,f), step = skew ? 2 : 1;
+    for (size_t k=step; k<L; k+=step) c[k] = flips_c(f,m,k);
+    this->e = e;
+    for (size_t a=0; a<m; a++) seq[f[a]] = (value)(-seq[f[a]]);
     #ifndef NDEBUG
     int update_e = e;
     evaluate_e();
@@ -116,7 +296,8 @@ void LABS::update_psl(const size_t i, const int psl){
     const size_t lmt = max(L-i,i+1);
     size_t k=1;
     int ck;
-    for (; k<lmt; k++){
+    if(skew) for (k=2; k<lmt; k+=2) c[k] -= 2*skew_delta(i,k);
+    else for (; k<lmt; k++){
         ck = c[k];
         if(i+k<L) ck -= 2*seq[i]*seq[k+i];
         if(k<=i) ck -= 2*seq[i-k]*seq[i];
@@ -124,6 +305,20 @@ void LABS::update_psl(const size_t i, const int psl){
     }
     this->psl = psl;
     seq[i] = (value)(-seq[i]);
+    if(skew && L-1-i != i) seq[L-1-i] = (value)(-seq[L-1-i]);
+    #ifndef NDEBUG
+    int update_psl = psl;
+    evaluate_psl();
+    if(psl != update_psl) throw string("Wrong PSL!");
+    #endif
+}
+
+void LABS::update2_psl(const size_t i, const size_t j, const int psl){
+    size_t f[4];
+    const size_t m = pair_flips(i,j,f), step = skew ? 2 : 1;
+    for (size_t k=step; k<L; k+=step) c[k] = flips_c(f,m,k);
+    this->psl = psl;
+    for (size_t a=0; a<m; a++) seq[f[a]] = (value)(-seq[f[a]]);
     #ifndef NDEBUG
     int update_psl = psl;
     evaluate_psl();
@@ -131,30 +326,143 @@ void LABS::update_psl(const size_t i, const int psl){
     #endif
 }
 
-LABS LABS::neighborhood_search_e(const size_t seed, const size_t n, const size_t L){
-    LABS current(L), best(L);
+// Lokalno iskanje: vedno vzamemo najboljso izboljsavo z eno zamenjavo. V lokalnem
+// optimumu poiscemo prvi par zamenjav, ki izboljsa resitev; samples=0 pregleda vse
+// pare od nakljucnega zacetka naprej, sicer jih nakljucno izberemo samples. Iz
+// nakljucnega zaporedja (ali delno, glej Restart) zacnemo, ce tudi noben par ne
+// izboljsa ali ce tako odloci politika ponovnih zagonov.
+LABS LABS::neighborhood_search_e(const size_t seed, const size_t n, const size_t L, const size_t samples,
+                                 const bool skew, const Restart & policy){
+    LABS current(L,skew), best(L,skew);
     mt19937 rand(seed);
     best.random(rand);
     best.evaluate_e();
     current = best;
-    size_t nfes=0, best_neighbor;
-    int best_neighbor_e, e;
+    const size_t M = current.moves(); // stevilo sosedov, v skew nacinu (L+1)/2
+    size_t nfes=0, best_neighbor=0;
+    int best_neighbor_e, e, run_e = current.get_e();
+    Restart restart = policy;
     while(nfes < n){
-	    // ???
+        best_neighbor_e = numeric_limits<int>::max();
+        for(size_t i=0; i<M; i++){
+            e = current.neighbor_e(i);
+            if(e < best_neighbor_e){
+                best_neighbor = i;
+                best_neighbor_e = e;
+            }
+        }
+        nfes+=M;
+        bool improved = false;
+        if(best_neighbor_e < current.get_e()){
+            current.update_e(best_neighbor,best_neighbor_e);
+            improved = true;
+        }
+        auto try_pair = [&](const size_t i, const size_t j){
+            e = current.neighbor2_e(i,j);
+            nfes++;
+            if(e < current.get_e()){
+                current.update2_e(i,j,e);
+                improved = true;
+            }
+        };
+        if(!improved && samples){
+            for(size_t t=0; t<samples && nfes<n && !improved; t++){
+                const size_t i = rand()%M, j = rand()%(M-1);
+                try_pair(i, j >= i ? j+1 : j);
+            }
+        }
+        else if(!improved){
+            const size_t start = rand()%M;
+            for(size_t a=0; a<M && !improved; a++){
+                const size_t i = (start+a)%M;
+                for(size_t j=i+1; j<M && nfes<n && !improved; j++) try_pair(i,j);
+            }
+        }
+        if(current.get_e() < best.get_e()) best = current;
+        const bool run_improved = current.get_e() < run_e;
+        if(run_improved) run_e = current.get_e();
+        if(restart.step(run_improved) || !improved){
+            if(restart.get_perturb()){
+                current = best;
+                current.perturb_e(restart.get_perturb(), rand);
+                nfes += restart.get_perturb();
+            }
+            else{
+                current.random(rand);
+                current.evaluate_e();
+                nfes++;
+            }
+            run_e = current.get_e();
+            if(current.get_e() < best.get_e()) best = current;
+        }
     }
     return best;
 }
 
-LABS LABS::neighborhood_search_psl(const size_t seed, const size_t n, const size_t L){
-    LABS current(L), best(L);
+LABS LABS::neighborhood_search_psl(const size_t seed, const size_t n, const size_t L, const size_t samples,
+                                   const bool skew, const Restart & policy){
+    LABS current(L,skew), best(L,skew);
     mt19937 rand(seed);
     best.random(rand);
     best.evaluate_psl();
     current = best;
-    size_t nfes=0, best_neighbor;
-    int best_neighbor_psl, psl;
+    const size_t M = current.moves(); // stevilo sosedov, v skew nacinu (L+1)/2
+    size_t nfes=0, best_neighbor=0;
+    int best_neighbor_psl, psl, run_psl = current.get_psl();
+    Restart restart = policy;
     while(nfes < n){
-	    // ???
+        best_neighbor_psl = numeric_limits<int>::max();
+        for(size_t i=0; i<M; i++){
+            psl = current.neighbor_psl(i);
+            if(psl < best_neighbor_psl){
+                best_neighbor = i;
+                best_neighbor_psl = psl;
+            }
+        }
+        nfes+=M;
+        bool improved = false;
+        if(best_neighbor_psl < current.get_psl()){
+            current.update_psl(best_neighbor,best_neighbor_psl);
+            improved = true;
+        }
+        auto try_pair = [&](const size_t i, const size_t j){
+            psl = current.neighbor2_psl(i,j);
+            nfes++;
+            if(psl < current.get_psl()){
+                current.update2_psl(i,j,psl);
+                improved = true;
+            }
+        };
+        if(!improved && samples){
+            for(size_t t=0; t<samples && nfes<n && !improved; t++){
+                const size_t i = rand()%M, j = rand()%(M-1);
+                try_pair(i, j >= i ? j+1 : j);
+            }
+        }
+        else if(!improved){
+            const size_t start = rand()%M;
+            for(size_t a=0; a<M && !improved; a++){
+                const size_t i = (start+a)%M;
+                for(size_t j=i+1; j<M && nfes<n && !improved; j++) try_pair(i,j);
+            }
+        }
+        if(current.get_psl() < best.get_psl()) best = current;
+        const bool run_improved = current.get_psl() < run_psl;
+        if(run_improved) run_psl = current.get_psl();
+        if(restart.step(run_improved) || !improved){
+            if(restart.get_perturb()){
+                current = best;
+                current.perturb_psl(restart.get_perturb(), rand);
+                nfes += restart.get_perturb();
+            }
+            else{
+                current.random(rand);
+                current.evaluate_psl();
+                nfes++;
+            }
+            run_psl = current.get_psl();
+            if(current.get_psl() < best.get_psl()) best = current;
+        }
     }
     return best;
 }
@@ -164,9 +472,29 @@ int main(int argc, char *argv[]){
         if(argc < 4) throw string("Three arguments are required!");
 
         const size_t seed =atoi(argv[1]), n = atoi(argv[2]), D = atoi(argv[3]);
+        if(D < 2) throw string("Sequence length must be at least 2!");
+        // Cetrti argument je stevilo nakljucnih parov v lokalnem optimumu, 0 pregleda vse pare.
+        // Nato lahko sledi "skew" za skew-simetricna zaporedja lihe dolzine, politika ponovnih
+        // zagonov ("luby", "geometric", "stagnation") in "perturb=k" za delni zagon; privzeto
+        // zacnemo znova le, ko ni izboljsave.
+        const size_t samples = argc > 4 ? atoi(argv[4]) : 0;
+        Restart::policy policy = Restart::fixed;
+        size_t unit = numeric_limits<size_t>::max(), perturb = 0;
+        bool skew = false;
+        for(int a=5; a<argc; a++){
+            const string arg = argv[a];
+            if(arg == "skew") skew = true;
+            else if(arg == "luby") policy = Restart::luby;
+            else if(arg == "geometric") policy = Restart::geometric;
+            else if(arg == "stagnation") policy = Restart::stagnation;
+            else if(arg.compare(0, 8, "perturb=") == 0) perturb = atoi(arg.c_str()+8);
+            else throw string("Unknown argument: ") + arg;
+            if(policy != Restart::fixed) unit = D;
+        }
+        const Restart restart(policy, unit, perturb);
         cout<<"Searching ..."<<endl;
         auto start = system_clock::now();
-        LABS best = LABS::neighborhood_search_e(seed,n,D);
+        LABS best = LABS::neighborhood_search_e(seed,n,D,samples,skew,restart);
         auto end = system_clock::now();
         auto elapsed = duration_cast<milliseconds>(end - start);
         cout<<"E: "<<best.get_e()<<" F: "<<best.get_mf() << endl;
@@ -176,7 +504,7 @@ int main(int argc, char *argv[]){
 
         cout<<"Searching ..."<<endl;
         start = system_clock::now();
-        best = LABS::neighborhood_search_psl(seed,n,D);
+        best = LABS::neighborhood_search_psl(seed,n,D,samples,skew,restart);
         end = system_clock::now();
         elapsed = duration_cast<milliseconds>(end - start);
         cout<<"PSL: "<<best.get_psl();
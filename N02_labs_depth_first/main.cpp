@@ -3,95 +3,166 @@
 #include <chrono>
 #include <vector>
 #include <limits>
+#include <cstdint>
+#include <algorithm>
 
 using namespace std;
 using namespace std::chrono;
 
+// Politika ponovnih zagonov. fixed zacne znova vsakih unit korakov, luby po
+// unit*luby(r) korakih, geometric po unit*1.5^r korakih (r je stevilo dosedanjih
+// zagonov), stagnation pa po unit korakih brez izboljsave v trenutnem zagonu.
+// perturb>0 pomeni delni zagon: namesto novega nakljucnega zaporedja zamenjamo
+// perturb nakljucnih elementov najboljse resitve, c[] pa popravimo inkrementalno.
+class Restart{
+public:
+    enum policy { fixed, luby, geometric, stagnation };
+    Restart(const policy type, const size_t unit, const size_t perturb):
+        type(type), unit(unit), perturb(perturb), restarts(0), steps(0), lmt(unit) {}
+    // Klicemo po vsakem koraku; vrne true, ko je cas za ponovni zagon.
+    bool step(const bool improved){
+        if(type == stagnation && improved) steps = 0;
+        if(++steps < lmt) return false;
+        steps = 0;
+        restarts++;
+        if(type == luby) lmt = unit*luby_seq(restarts+1);
+        else if(type == geometric) lmt = lmt + lmt/2;
+        return true;
+    }
+    inline size_t get_perturb() const { return perturb; }
+    static size_t luby_seq(const size_t i); // 1 1 2 1 1 2 4 1 1 2 ...
+
+private:
+    const policy type;
+    const size_t unit, perturb;
+    size_t restarts, steps, lmt;
+};
+
+size_t Restart::luby_seq(const size_t i){
+    size_t k = 1;
+    while(((size_t)1<<k)-1 < i) k++;
+    if(i == ((size_t)1<<k)-1) return (size_t)1<<(k-1);
+    return luby_seq(i - ((size_t)1<<(k-1)) + 1);
+}
+
 class LABS{
 public:
     enum value { p=+1, n=-1};
-    LABS(const size_t L): L(L), seq(L,p), c(L,0),
+    LABS(const size_t L): L(L), seq(L,p), c(L,0), tail(L+1,0), peak(L+1,0),
           e(numeric_limits<int>::max()), psl(numeric_limits<int>::max()) {};
-    LABS(const LABS & l): L(l.L), seq(l.seq), c(l.c), e(l.e), psl(l.psl) {}
+    LABS(const LABS & l): L(l.L), seq(l.seq), c(l.c), tail(l.tail), peak(l.peak), e(l.e), psl(l.psl) {}
     LABS& operator=(const LABS & l);
     inline double get_mf() const { return (L*L)/(2.0*e); }
     inline int get_e() const { return e; }
     inline int get_psl() const { return psl; }
     void random(mt19937 & rand);
+    void perturb_e(const size_t k, mt19937 & rand);
+    void perturb_psl(const size_t k, mt19937 & rand);
     void evaluate_e();
     void evaluate_psl();
     int neighbor_e(const size_t n) const;
     int neighbor_psl(const size_t n) const;
     void update_e(const size_t n, const int e);
     void update_psl(const size_t n, const int psl);
-    static LABS depth_first_search_e(const size_t seed, const size_t n, const size_t L);
-    static LABS depth_first_search_psl(const size_t seed, const size_t n, const size_t L);
+    static LABS depth_first_search_e(const size_t seed, const size_t n, const size_t L, const Restart & restart);
+    static LABS depth_first_search_psl(const size_t seed, const size_t n, const size_t L, const Restart & restart);
 
 private:
     const size_t L;
     vector<value> seq;
     vector<int> c;
+    vector<int> tail; // tail[k] = sum c[j]^2 za j>=k, velja po evaluate_e in update_e
+    vector<int> peak; // peak[k] = max |c[j]| za j>=k, velja po evaluate_psl in update_psl
     int e, psl;
 };
 
 LABS& LABS::operator=(const LABS & l){
     if(L != l.L) throw std::string("Sequences with diferent length!");
-    seq=l.seq; c=l.c; e=l.e; psl=l.psl; return *this;
+    seq=l.seq; c=l.c; tail=l.tail; peak=l.peak; e=l.e; psl=l.psl; return *this;
 }
 
 void LABS::random(mt19937 & rand){
-    for(size_t i=0; i<L; i++){
-        if(rand()%2) seq[i] = p;
-        else seq[i] = n;
+    // En klic generatorja da 32 nakljucnih elementov.
+    for(size_t i=0; i<L; i+=32){
+        const uint32_t w = rand();
+        for(size_t j=i; j<min(L, i+32); j++) seq[j] = (w>>(j-i))&1 ? p : n;
+    }
+}
+
+// Delni zagon: k nakljucnih zamenjav, vsaka stane O(L) namesto O(L^2) za evaluate_e.
+void LABS::perturb_e(const size_t k, mt19937 & rand){
+    for(size_t t=0; t<k; t++){
+        const size_t i = rand()%L;
+        update_e(i, neighbor_e(i));
+    }
+}
+
+void LABS::perturb_psl(const size_t k, mt19937 & rand){
+    for(size_t t=0; t<k; t++){
+        const size_t i = rand()%L;
+        update_psl(i, neighbor_psl(i));
     }
 }
 
 void LABS::evaluate_e(){
-    e = 0;
     for (size_t k=1; k<L; k++) {
         c[k]=0;
         for (size_t i=0; i<=L-k-1; i++) c[k] += seq[i]*seq[i+k];
-        e += c[k]*c[k];
     }
+    tail[L] = 0;
+    for (size_t k=L-1; k>=1; k--) tail[k] = tail[k+1] + c[k]*c[k];
+    e = tail[1];
 }
 
 void LABS::evaluate_psl(){
-    psl = 0;
     for (size_t k=1; k<L; k++) {
         c[k]=0;
         for (size_t i=0; i<=L-k-1; i++) c[k] += seq[i]*seq[i+k];
-        if(abs(c[k]) > psl) psl = abs(c[k]);
     }
+    peak[L] = 0;
+    for (size_t k=L-1; k>=1; k--) peak[k] = max(peak[k+1], abs(c[k]));
+    psl = peak[1];
 }
 
+// Iskanje klice neighbor_e za posamezne sosede, zato zanko razdelimo na obmocja k,
+// kjer obstajata oba, le desni ali le levi sosed, in se znebimo pogojev. Zamiki od
+// max(L-i,i+1) naprej se ne spremenijo, njihov prispevek preberemo iz tail/peak.
 int LABS::neighbor_e(const size_t i) const{
     int e = 0, ck;
-    const size_t lmt = std::max(L-i,i+1);
+    const int si = 2*seq[i];
     size_t k=1;
-    for(;k<lmt; k++) {
-        ck = c[k];
-        if(i+k<L) ck -= 2*seq[i]*seq[k+i];
-        if(k<=i) ck -= 2*seq[i-k]*seq[i];
+    for(; k<min(L-i,i+1); k++){
+        ck = c[k] - si*(seq[k+i] + seq[i-k]);
         e += ck*ck;
     }
-    for (; k<L; k++) e += c[k]*c[k];
-    return e;
+    for(; k<L-i; k++){
+        ck = c[k] - si*seq[k+i];
+        e += ck*ck;
+    }
+    for(; k<=i; k++){
+        ck = c[k] - si*seq[i-k];
+        e += ck*ck;
+    }
+    return e + tail[k];
 }
 
 int LABS::neighbor_psl(const size_t i) const{
     int psl = 0, ck;
-    const size_t lmt = max(L-i,i+1);
+    const int si = 2*seq[i];
     size_t k=1;
-    for(; k<lmt; k++) {
-        ck = c[k];
-        if(i+k<L) ck -= 2*seq[i]*seq[k+i];
-        if(k<=i) ck -= 2*seq[i-k]*seq[i];
-        if(abs(ck) > psl) psl = abs(ck);
+    for(; k<min(L-i,i+1); k++){
+        ck = c[k] - si*(seq[k+i] + seq[i-k]);
+        psl = max(psl, abs(ck));
+    }
+    for(; k<L-i; k++){
+        ck = c[k] - si*seq[k+i];
+        psl = max(psl, abs(ck));
     }
-    for (size_t k=1; k<L; k++){
-        if(abs(c[k]) > psl) psl = abs(c[k]);
+    for(; k<=i; k++){
+        ck = c[k] - si*seq[i-k];
+        psl = max(psl, abs(ck));
     }
-    return psl;
+    return max(psl, peak[k]);
 }
 
 void LABS::update_e(const size_t i, const int e){
@@ -103,12 +174,14 @@ void LABS::update_e(const size_t i, const int e){
         if(k<=i) ck -= 2*seq[i-k]*seq[i];
         c[k] = ck;
     }
+    for (k=lmt-1; k>=1; k--) tail[k] = tail[k+1] + c[k]*c[k];
     this->e = e;
     seq[i] = (value)(-seq[i]);
     #ifndef NDEBUG
     int update_e = e;
+    auto update_tail = tail;
     evaluate_e();
-    if(e != update_e) throw string("Wrong E!");
+    if(e != update_e || tail != update_tail) throw string("Wrong E!");
     #endif
 }
 
@@ -122,41 +195,103 @@ void LABS::update_psl(const size_t i, const int psl){
         if(k<=i) ck -= 2*seq[i-k]*seq[i];
         c[k] = ck;
     }
+    for (k=lmt-1; k>=1; k--) peak[k] = max(peak[k+1], abs(c[k]));
     this->psl = psl;
     seq[i] = (value)(-seq[i]);
     #ifndef NDEBUG
     int update_psl = psl;
+    auto update_peak = peak;
     evaluate_psl();
-    if(psl != update_psl) throw string("Wrong PSL!");
+    if(psl != update_psl || peak != update_peak) throw string("Wrong PSL!");
     #endif
 }
 
-LABS LABS::depth_first_search_e(const size_t seed, const size_t n, const size_t L){
+LABS LABS::depth_first_search_e(const size_t seed, const size_t n, const size_t L, const Restart & policy){
     LABS current(L), best(L);
     mt19937 rand(seed);
     best.random(rand);
     best.evaluate_e();
     current = best;
-    const size_t stepLmt = 8*L;
-    size_t nfes=0, best_neighbor, step=0,start, i, idx;
-    int best_neighbor_e, e;
+    size_t nfes=0, best_neighbor=0, start, i, idx;
+    int best_neighbor_e, e, run_e = current.get_e(); // run_e je najboljsa E trenutnega zagona
+    Restart restart = policy;
     while(nfes < n){
-	    // ???
+        // Prva izboljsava: sosede pregledujemo od nakljucnega zacetka naprej (z ovijanjem)
+        // in vzamemo prvega, ki izboljsa E. Ce ga ni, vzamemo najboljsega soseda.
+        start = rand()%L;
+        best_neighbor_e = numeric_limits<int>::max();
+        for(i=0; i<L; i++){
+            idx = start+i < L ? start+i : start+i-L;
+            e = current.neighbor_e(idx);
+            nfes++;
+            if(e < best_neighbor_e){
+                best_neighbor = idx;
+                best_neighbor_e = e;
+                if(e < current.get_e()) break;
+            }
+        }
+        current.update_e(best_neighbor,best_neighbor_e);
+        if(current.get_e() < best.get_e()) best = current;
+        const bool improved = current.get_e() < run_e;
+        if(improved) run_e = current.get_e();
+        if(restart.step(improved)){
+            if(restart.get_perturb()){
+                current = best;
+                current.perturb_e(restart.get_perturb(), rand);
+                nfes += restart.get_perturb();
+            }
+            else{
+                current.random(rand);
+                current.evaluate_e();
+                nfes++;
+            }
+            run_e = current.get_e();
+            if(current.get_e() < best.get_e()) best = current;
+        }
     }
     return best;
 }
 
-LABS LABS::depth_first_search_psl(const size_t seed, const size_t n, const size_t L){
+LABS LABS::depth_first_search_psl(const size_t seed, const size_t n, const size_t L, const Restart & policy){
     LABS current(L), best(L);
     mt19937 rand(seed);
     best.random(rand);
     best.evaluate_psl();
     current = best;
-    const size_t stepLmt = 8*L;
-    size_t nfes=0, best_neighbor, step=0, start, idx, i;
-    int best_neighbor_psl, psl;
+    size_t nfes=0, best_neighbor=0, start, idx, i;
+    int best_neighbor_psl, psl, run_psl = current.get_psl();
+    Restart restart = policy;
     while(nfes < n){
-	    // ???
+        start = rand()%L;
+        best_neighbor_psl = numeric_limits<int>::max();
+        for(i=0; i<L; i++){
+            idx = start+i < L ? start+i : start+i-L;
+            psl = current.neighbor_psl(idx);
+            nfes++;
+            if(psl < best_neighbor_psl){
+                best_neighbor = idx;
+                best_neighbor_psl = psl;
+                if(psl < current.get_psl()) break;
+            }
+        }
+        current.update_psl(best_neighbor,best_neighbor_psl);
+        if(current.get_psl() < best.get_psl()) best = current;
+        const bool improved = current.get_psl() < run_psl;
+        if(improved) run_psl = current.get_psl();
+        if(restart.step(improved)){
+            if(restart.get_perturb()){
+                current = best;
+                current.perturb_psl(restart.get_perturb(), rand);
+                nfes += restart.get_perturb();
+            }
+            else{
+                current.random(rand);
+                current.evaluate_psl();
+                nfes++;
+            }
+            run_psl = current.get_psl();
+            if(current.get_psl() < best.get_psl()) best = current;
+        }
     }
     return best;
 }
@@ -166,9 +301,22 @@ int main(int argc, char *argv[]){
         if(argc < 4) throw string("Three arguments are required!");
 
         const size_t seed =atoi(argv[1]), n = atoi(argv[2]), L = atoi(argv[3]);
+        // Dodatni argumenti: "luby", "geometric" ali "stagnation" izbere politiko ponovnih
+        // zagonov, "perturb=k" pa delni zagon, ki zamenja k elementov najboljse resitve.
+        Restart::policy policy = Restart::fixed;
+        size_t perturb = 0;
+        for(int a=4; a<argc; a++){
+            const string arg = argv[a];
+            if(arg == "luby") policy = Restart::luby;
+            else if(arg == "geometric") policy = Restart::geometric;
+            else if(arg == "stagnation") policy = Restart::stagnation;
+            else if(arg.compare(0, 8, "perturb=") == 0) perturb = atoi(arg.c_str()+8);
+            else throw string("Unknown argument: ") + arg;
+        }
+        const Restart restart(policy, policy == Restart::fixed ? 8*L : L, perturb);
         cout<<"Searching ..."<<endl;
         auto start = system_clock::now();
-        LABS best = LABS::depth_first_search_e(seed,n,L);
+        LABS best = LABS::depth_first_search_e(seed,n,L,restart);
         auto end = system_clock::now();
         auto elapsed = duration_cast<milliseconds>(end - start);
         cout<<"E: "<<best.get_e()<<" F: "<<best.get_mf();
@@ -176,7 +324,7 @@ int main(int argc, char *argv[]){
 
         cout<<"Searching ..."<<endl;
         start = system_clock::now();
-        best = LABS::depth_first_search_psl(seed,n,L);
+        best = LABS::depth_first_search_psl(seed,n,L,restart);
         end = system_clock::now();
         elapsed = duration_cast<milliseconds>(end - start);
         cout<<"PSL: "<<best.get_psl();
@@ -0,0 +1,537 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <vector>
+#include <array>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+using namespace std::chrono;
+
+// Dolzina zaporedja: N>0 je znana ob prevajanju, N=0 pomeni dolzino ob izvajanju.
+template<size_t N> struct Length{
+    static constexpr size_t L = N;
+    Length(const size_t L){ if(L != N) throw string("Wrong sequence length!"); }
+};
+template<size_t N> constexpr size_t Length<N>::L;
+
+template<> struct Length<0>{
+    const size_t L;
+    Length(const size_t L): L(L) {}
+};
+
+// Polje s fiksno dolzino (std::array) ali vector, ce dolzina ni znana ob prevajanju.
+template<class T, size_t N> struct Buffer: array<T,N>{
+    Buffer(const size_t, const T v){ this->fill(v); }
+};
+
+template<class T> struct Buffer<T,0>: vector<T>{
+    Buffer(const size_t n, const T v): vector<T>(n,v) {}
+};
+
+// Politika ponovnih zagonov. fixed zacne znova vsakih unit korakov, luby po
+// unit*luby(r) korakih, geometric po unit*1.5^r korakih (r je stevilo dosedanjih
+// zagonov), stagnation pa po unit korakih brez izboljsave v trenutnem zagonu.
+// perturb>0 pomeni delni zagon: namesto novega nakljucnega zaporedja zamenjamo
+// perturb nakljucnih elementov najboljse resitve, c[] pa popravimo inkrementalno.
+class Restart{
+public:
+    enum policy { fixed, luby, geometric, stagnation };
+    Restart(const policy type, const size_t unit, const size_t perturb):
+        type(type), unit(unit), perturb(perturb), restarts(0), steps(0), lmt(unit) {}
+    // Klicemo po vsakem koraku; vrne true, ko je cas za ponovni zagon.
+    bool step(const bool improved){
+        if(type == stagnation && improved) steps = 0;
+        if(++steps < lmt) return false;
+        steps = 0;
+        restarts++;
+        if(type == luby) lmt = unit*luby_seq(restarts+1);
+        else if(type == geometric) lmt = lmt + lmt/2;
+        return true;
+    }
+    inline size_t get_perturb() const { return perturb; }
+    static size_t luby_seq(const size_t i); // 1 1 2 1 1 2 4 1 1 2 ...
+
+private:
+    const policy type;
+    const size_t unit, perturb;
+    size_t restarts, steps, lmt;
+};
+
+size_t Restart::luby_seq(const size_t i){
+    size_t k = 1;
+    while(((size_t)1<<k)-1 < i) k++;
+    if(i == ((size_t)1<<k)-1) return (size_t)1<<(k-1);
+    return luby_seq(i - ((size_t)1<<(k-1)) + 1);
+}
+
+
+// Skew-simetricno zaporedje lihe dolzine L=2m-1 ima s[m-1+j] = (-1)^j s[m-1-j].
+// Vsi lihi c[k] so 0, zato racunamo le sode zamike. Prostih elementov je m, poteza
+// i < m-1 zamenja s[i] in zrcalni s[L-1-i] hkrati, poteza m-1 pa sredinski element.
+template<size_t N=0>
+class LABS: Length<N>{
+public:
+    enum value { p=+1, n=-1};
+    typedef Buffer<int,N> ints;
+    LABS(const size_t L, const bool skew=false): Length<N>(L), skew(skew), seq(L,p), c(L,0), tail(L+1,0), peak(L+1,0),
+          e(numeric_limits<int>::max()), psl(numeric_limits<int>::max()) {
+        if(skew && L%2 == 0) throw string("Skew-symmetric sequences need odd length!");
+    };
+    LABS(const LABS & l): Length<N>(l.L), skew(l.skew), seq(l.seq), c(l.c), tail(l.tail), peak(l.peak), e(l.e), psl(l.psl) {}
+    LABS& operator=(const LABS & l);
+    inline double get_mf() const { return (L*L)/(2.0*e); }
+    inline int get_e() const { return e; }
+    inline int get_psl() const { return psl; }
+    inline size_t moves() const { return skew ? (L+1)/2 : L; }
+    void random(mt19937 & rand);
+    void perturb_e(const size_t k, mt19937 & rand);
+    void perturb_psl(const size_t k, mt19937 & rand);
+    void evaluate_e();
+    void evaluate_psl();
+    int neighbor_e(const size_t n) const;
+    void neighborhood_e(ints & ne) const;
+    int neighbor_psl(const size_t n) const;
+    void update_e(const size_t n, const int e);
+    void update_psl(const size_t n, const int psl);
+    static LABS tabu_search_e(const size_t seed, const size_t n, const size_t L, const bool skew,
+                              const Restart & restart);
+    static LABS tabu_search_psl(const size_t seed, const size_t n, const size_t L, const bool skew,
+                                const Restart & restart);
+
+private:
+    int skew_delta(const size_t i, const size_t k) const;
+    void skew_neighborhood_e(ints & ne) const;
+    void check_skew() const;
+    using Length<N>::L;
+    bool skew;
+    Buffer<value,N> seq;
+    ints c;
+    Buffer<int,N ? N+1 : 0> tail; // tail[k] = sum c[j]^2 za j>=k, velja po evaluate_e in update_e
+    Buffer<int,N ? N+1 : 0> peak; // peak[k] = max |c[j]| za j>=k, velja po evaluate_psl in update_psl
+    int e, psl;
+};
+
+template<size_t N>
+LABS<N>& LABS<N>::operator=(const LABS & l){
+    if(L != l.L) throw std::string("Sequences with diferent length!");
+    skew=l.skew; seq=l.seq; c=l.c; tail=l.tail; peak=l.peak; e=l.e; psl=l.psl; return *this;
+}
+
+template<size_t N>
+void LABS<N>::random(mt19937 & rand){
+    // En klic generatorja da 32 nakljucnih elementov.
+    for(size_t i=0; i<moves(); i+=32){
+        const uint32_t w = rand();
+        for(size_t j=i; j<min(moves(), i+32); j++) seq[j] = (w>>(j-i))&1 ? p : n;
+    }
+    if(skew){
+        const size_t m = moves();
+        for(size_t i=0; i+1<m; i++) seq[L-1-i] = (m-1-i)%2 ? (value)(-seq[i]) : seq[i];
+    }
+}
+
+// Delni zagon: k nakljucnih zamenjav, vsaka stane O(L) namesto O(L^2) za evaluate_e.
+template<size_t N>
+void LABS<N>::perturb_e(const size_t k, mt19937 & rand){
+    for(size_t t=0; t<k; t++){
+        const size_t i = rand()%moves();
+        update_e(i, neighbor_e(i));
+    }
+}
+
+template<size_t N>
+void LABS<N>::perturb_psl(const size_t k, mt19937 & rand){
+    for(size_t t=0; t<k; t++){
+        const size_t i = rand()%moves();
+        update_psl(i, neighbor_psl(i));
+    }
+}
+
+template<size_t N>
+void LABS<N>::evaluate_e(){
+    const size_t step = skew ? 2 : 1;
+    for (size_t k=1; k<L; k++) c[k]=0;
+    for (size_t k=step; k<L; k+=step) {
+        for (size_t i=0; i<=L-k-1; i++) c[k] += seq[i]*seq[i+k];
+    }
+    #ifndef NDEBUG
+    check_skew();
+    #endif
+    tail[L] = 0;
+    for (size_t k=L-1; k>=1; k--) tail[k] = tail[k+1] + c[k]*c[k];
+    e = tail[1];
+}
+
+template<size_t N>
+void LABS<N>::evaluate_psl(){
+    const size_t step = skew ? 2 : 1;
+    for (size_t k=1; k<L; k++) c[k]=0;
+    for (size_t k=step; k<L; k+=step) {
+        for (size_t i=0; i<=L-k-1; i++) c[k] += seq[i]*seq[i+k];
+    }
+    #ifndef NDEBUG
+    check_skew();
+    #endif
+    peak[L] = 0;
+    for (size_t k=L-1; k>=1; k--) peak[k] = max(peak[k+1], abs(c[k]));
+    psl = peak[1];
+}
+
+// Preveri, da so lihi c[k] res 0, ker jih skew-simetricne funkcije ne racunajo.
+template<size_t N>
+void LABS<N>::check_skew() const{
+    if(!skew) return;
+    for (size_t k=1; k<L; k+=2){
+        int ck = 0;
+        for (size_t i=0; i<=L-k-1; i++) ck += seq[i]*seq[i+k];
+        if(ck) throw string("Sequence is not skew-symmetric!");
+    }
+}
+
+// Za koliko se zmanjsa c[k]/2 (k sod), ce hkrati zamenjamo s[i] in zrcalni s[m], m = L-1-i.
+// Pri sodem k je s[m]*(s[m+k] + s[m-k]) = s[i]*(s[i-k] + s[i+k]), zato zrcalni element
+// le podvoji prispevek s[i]. Produkt s[i]*s[m] pri k = m-i ostane enak.
+template<size_t N>
+int LABS<N>::skew_delta(const size_t i, const size_t k) const{
+    const size_t m = L-1-i;
+    int d = 0;
+    if(i+k<L) d += seq[i]*seq[k+i];
+    if(k<=i) d += seq[i-k]*seq[i];
+    if(m != i){
+        d *= 2;
+        if(k == m-i) d -= 2*seq[i]*seq[m];
+    }
+    return d;
+}
+
+template<size_t N>
+int LABS<N>::neighbor_e(const size_t i) const{
+    int e = 0, ck;
+    const size_t lmt = std::max(L-i,i+1);
+    size_t k=1;
+    if(skew){
+        for(k=2; k<lmt; k+=2){
+            ck = c[k] - 2*skew_delta(i,k);
+            e += ck*ck;
+        }
+        return e + tail[min(k,L)];
+    }
+    for(;k<lmt; k++) {
+        ck = c[k];
+        if(i+k<L) ck -= 2*seq[i]*seq[k+i];
+        if(k<=i) ck -= 2*seq[i-k]*seq[i];
+        e += ck*ck;
+    }
+    return e + tail[k];
+}
+
+// Energije vseh L sosedov v enem prehodu. Po zamenjavi s[i] je
+// c'[k] = c[k] - 2*s[i]*d[k], d[k] = s[i+k] + s[i-k], zato je
+// E' = E + 4*(sum d[k]^2 - s[i]*sum c[k]*d[k]). Elementi izven zaporedja so 0,
+// tako da notranja zanka nima pogojev.
+template<size_t N>
+void LABS<N>::neighborhood_e(ints & ne) const{
+    if(skew) return skew_neighborhood_e(ne);
+    Buffer<int,3*N> f(3*L,0), b(3*L,0); // f[L+j] = s[j], b[L+j] = s[L-1-j]
+    for(size_t j=0; j<L; j++){
+        f[L+j] = seq[j];
+        b[2*L-1-j] = seq[j];
+    }
+    for(size_t i=0; i<L; i++){
+        const int *fi = &f[L+i], *bi = &b[2*L-1-i]; // fi[k] = s[i+k], bi[k] = s[i-k]
+        int cd = 0, dd = 0;
+        for(size_t k=1; k<L; k++){
+            const int d = fi[k] + bi[k];
+            cd += c[k]*d;
+            dd += d*d;
+        }
+        ne[i] = e + 4*(dd - seq[i]*cd);
+        #ifndef NDEBUG
+        if(ne[i] != neighbor_e(i)) throw string("Wrong neighborhood E!");
+        #endif
+    }
+}
+
+// Enako kot neighborhood_e, le da tecemo po sodih k in je d[k] zaradi zrcalnega
+// elementa podvojen (glej skew_delta). Popravek za s[i]*s[m] pristejemo po zanki.
+template<size_t N>
+void LABS<N>::skew_neighborhood_e(ints & ne) const{
+    Buffer<int,3*N> f(3*L,0), b(3*L,0);
+    for(size_t j=0; j<L; j++){
+        f[L+j] = seq[j];
+        b[2*L-1-j] = seq[j];
+    }
+    for(size_t i=0; i<moves(); i++){
+        const size_t m = L-1-i;
+        const int w = m != i ? 2 : 1;
+        const int *fi = &f[L+i], *bi = &b[2*L-1-i];
+        int cd = 0, dd = 0;
+        for(size_t k=2; k<L; k+=2){
+            const int d = w*(fi[k] + bi[k]);
+            cd += c[k]*d;
+            dd += d*d;
+        }
+        ne[i] = e + 4*(dd - seq[i]*cd);
+        if(m != i){
+            const size_t k = m-i;
+            const int d = seq[i]*w*(fi[k] + bi[k]), x = 2*seq[i]*seq[m];
+            ne[i] += 4*(x*x - 2*x*d + c[k]*x);
+        }
+        #ifndef NDEBUG
+        if(ne[i] != neighbor_e(i)) throw string("Wrong neighborhood E!");
+        #endif
+    }
+}
+
+template<size_t N>
+int LABS<N>::neighbor_psl(const size_t i) const{
+    int psl = 0, ck;
+    const size_t lmt = max(L-i,i+1);
+    size_t k=1;
+    if(skew){
+        for(k=2; k<lmt; k+=2){
+            ck = c[k] - 2*skew_delta(i,k);
+            if(abs(ck) > psl) psl = abs(ck);
+        }
+        return max(psl, peak[min(k,L)]);
+    }
+    for(; k<lmt; k++) {
+        ck = c[k];
+        if(i+k<L) ck -= 2*seq[i]*seq[k+i];
+        if(k<=i) ck -= 2*seq[i-k]*seq[i];
+        if(abs(ck) > psl) psl = abs(ck);
+    }
+    return max(psl, peak[k]);
+}
+
+template<size_t N>
+void LABS<N>::update_e(const size_t i, const int e){
+    const size_t lmt = max(L-i,i+1);
+    size_t k=1;
+    if(skew) for (k=2; k<lmt; k+=2) c[k] -= 2*skew_delta(i,k);
+    else for (;k<lmt; k++){
+        int ck = c[k];
+        if(i+k<L) ck -= 2*seq[i]*seq[k+i];
+        if(k<=i) ck -= 2*seq[i-k]*seq[i];
+        c[k] = ck;
+    }
+    for (k=lmt-1; k>=1; k--) tail[k] = tail[k+1] + c[k]*c[k];
+    this->e = e;
+    seq[i] = (value)(-seq[i]);
+    if(skew && L-1-i != i) seq[L-1-i] = (value)(-seq[L-1-i]);
+    #ifndef NDEBUG
+    int update_e = e;
+    auto update_tail = tail;
+    evaluate_e();
+    if(e != update_e || tail != update_tail) throw string("Wrong E!");
+    #endif
+}
+
+template<size_t N>
+void LABS<N>::update_psl(const size_t i, const int psl){
+    const size_t lmt = max(L-i,i+1);
+    size_t k=1;
+    int ck;
+    if(skew) for (k=2; k<lmt; k+=2) c[k] -= 2*skew_delta(i,k);
+    else for (; k<lmt; k++){
+        ck = c[k];
+        if(i+k<L) ck -= 2*seq[i]*seq[k+i];
+        if(k<=i) ck -= 2*seq[i-k]*seq[i];
+        c[k] = ck;
+    }
+    for (k=lmt-1; k>=1; k--) peak[k] = max(peak[k+1], abs(c[k]));
+    this->psl = psl;
+    seq[i] = (value)(-seq[i]);
+    if(skew && L-1-i != i) seq[L-1-i] = (value)(-seq[L-1-i]);
+    #ifndef NDEBUG
+    int update_psl = psl;
+    auto update_peak = peak;
+    evaluate_psl();
+    if(psl != update_psl || peak != update_peak) throw string("Wrong PSL!");
+    #endif
+}
+
+// Tabu iskanje: vedno naredimo najboljso dovoljeno zamenjavo, tudi ce je slabsa.
+// Zamenjan element je nato tabu minTenure + rand()%extraTenure korakov, razen
+// ce bi zamenjava dala novo najboljso resitev (aspiracija). Kdaj zacnemo znova
+// (iz nakljucnega zaporedja ali delno iz najboljse resitve), odloci Restart.
+template<size_t N>
+LABS<N> LABS<N>::tabu_search_e(const size_t seed, const size_t n, const size_t L, const bool skew,
+                                  const Restart & policy){
+    LABS current(L,skew), best(L,skew);
+    mt19937 rand(seed);
+    best.random(rand);
+    best.evaluate_e();
+    current = best;
+    const size_t M = current.moves(); // stevilo sosedov, v skew nacinu (L+1)/2
+    const size_t minTenure = max<size_t>(1,M/10), extraTenure = max<size_t>(1,M/10);
+    size_t nfes=0, best_neighbor, step=0;
+    int best_neighbor_e, run_e = current.get_e(); // run_e je najboljsa E trenutnega zagona
+    Restart restart = policy;
+    ints ne(L,0);
+    vector<size_t> tabu(M,0); // tabu[i] = prvi korak, v katerem je i spet dovoljen
+    while(nfes < n){
+        current.neighborhood_e(ne);
+        nfes+=M;
+        best_neighbor = M;
+        best_neighbor_e = numeric_limits<int>::max();
+        for(size_t i=0; i<M; i++){
+            if((tabu[i] <= step || ne[i] < best.get_e()) && ne[i] < best_neighbor_e){
+                best_neighbor = i;
+                best_neighbor_e = ne[i];
+            }
+        }
+        if(best_neighbor < M){
+            current.update_e(best_neighbor,best_neighbor_e);
+            tabu[best_neighbor] = step + minTenure + rand()%extraTenure;
+            if(current.get_e() < best.get_e()) best = current;
+        }
+        step++;
+        const bool improved = current.get_e() < run_e;
+        if(improved) run_e = current.get_e();
+        if(restart.step(improved)){
+            if(restart.get_perturb()){
+                current = best;
+                current.perturb_e(restart.get_perturb(), rand);
+                nfes += restart.get_perturb();
+            }
+            else{
+                current.random(rand);
+                current.evaluate_e();
+                nfes++;
+            }
+            run_e = current.get_e();
+            step = 0;
+            fill(tabu.begin(), tabu.end(), 0);
+            if(current.get_e() < best.get_e()) best = current;
+        }
+    }
+    return best;
+}
+
+template<size_t N>
+LABS<N> LABS<N>::tabu_search_psl(const size_t seed, const size_t n, const size_t L, const bool skew,
+                                  const Restart & policy){
+    LABS current(L,skew), best(L,skew);
+    mt19937 rand(seed);
+    best.random(rand);
+    best.evaluate_psl();
+    current = best;
+    const size_t M = current.moves(); // stevilo sosedov, v skew nacinu (L+1)/2
+    const size_t minTenure = max<size_t>(1,M/10), extraTenure = max<size_t>(1,M/10);
+    size_t nfes=0, best_neighbor, step=0;
+    int best_neighbor_psl, psl, run_psl = current.get_psl();
+    Restart restart = policy;
+    vector<size_t> tabu(M,0);
+    while(nfes < n){
+        best_neighbor = M;
+        best_neighbor_psl = numeric_limits<int>::max();
+        for(size_t i=0; i<M; i++){
+            psl = current.neighbor_psl(i);
+            if((tabu[i] <= step || psl < best.get_psl()) && psl < best_neighbor_psl){
+                best_neighbor = i;
+                best_neighbor_psl = psl;
+            }
+        }
+        nfes+=M;
+        if(best_neighbor < M){
+            current.update_psl(best_neighbor,best_neighbor_psl);
+            tabu[best_neighbor] = step + minTenure + rand()%extraTenure;
+            if(current.get_psl() < best.get_psl()) best = current;
+        }
+        step++;
+        const bool improved = current.get_psl() < run_psl;
+        if(improved) run_psl = current.get_psl();
+        if(restart.step(improved)){
+            if(restart.get_perturb()){
+                current = best;
+                current.perturb_psl(restart.get_perturb(), rand);
+                nfes += restart.get_perturb();
+            }
+            else{
+                current.random(rand);
+                current.evaluate_psl();
+                nfes++;
+            }
+            run_psl = current.get_psl();
+            step = 0;
+            fill(tabu.begin(), tabu.end(), 0);
+            if(current.get_psl() < best.get_psl()) best = current;
+        }
+    }
+    return best;
+}
+
+template<size_t N>
+void run(const size_t seed, const size_t n, const size_t L, const bool skew, const Restart & restart){
+    cout<<"Searching ..."<<endl;
+    auto start = system_clock::now();
+    LABS<N> best = LABS<N>::tabu_search_e(seed,n,L,skew,restart);
+    auto end = system_clock::now();
+    auto elapsed = duration_cast<milliseconds>(end - start);
+    cout<<"E: "<<best.get_e()<<" F: "<<best.get_mf();
+    cout<<" speed: "<<n/(elapsed.count()/1000.0)<<" eval/sec"<<endl;
+
+    cout<<"Searching ..."<<endl;
+    start = system_clock::now();
+    best = LABS<N>::tabu_search_psl(seed,n,L,skew,restart);
+    end = system_clock::now();
+    elapsed = duration_cast<milliseconds>(end - start);
+    cout<<"PSL: "<<best.get_psl();
+    cout<<" speed: "<<n/(elapsed.count()/1000.0)<<" eval/sec"<<endl;
+}
+
+int main(int argc, char *argv[]){
+    try{
+        if(argc < 4) throw string("Three arguments are required!");
+
+        const size_t seed =atoi(argv[1]), n = atoi(argv[2]), L = atoi(argv[3]);
+        // Dodatni argumenti: "skew" omeji iskanje na skew-simetricna zaporedja lihe dolzine,
+        // "luby", "geometric" ali "stagnation" izbere politiko ponovnih zagonov,
+        // "perturb=k" pa delni zagon, ki zamenja k elementov najboljse resitve.
+        bool skew = false;
+        Restart::policy policy = Restart::fixed;
+        size_t perturb = 0;
+        for(int a=4; a<argc; a++){
+            const string arg = argv[a];
+            if(arg == "skew") skew = true;
+            else if(arg == "luby") policy = Restart::luby;
+            else if(arg == "geometric") policy = Restart::geometric;
+            else if(arg == "stagnation") policy = Restart::stagnation;
+            else if(arg.compare(0, 8, "perturb=") == 0) perturb = atoi(arg.c_str()+8);
+            else throw string("Unknown argument: ") + arg;
+        }
+        const Restart restart(policy, policy == Restart::fixed ? 8*L : L, perturb);
+        // Pogoste dolzine so prevedene s konstantno dolzino, ostale tecejo z LABS<0>
+        switch(L){
+        case 4: run<4>(seed,n,L,skew,restart); break;
+        case 5: run<5>(seed,n,L,skew,restart); break;
+        case 6: run<6>(seed,n,L,skew,restart); break;
+        case 7: run<7>(seed,n,L,skew,restart); break;
+        case 8: run<8>(seed,n,L,skew,restart); break;
+        case 9: run<9>(seed,n,L,skew,restart); break;
+        case 10: run<10>(seed,n,L,skew,restart); break;
+        case 11: run<11>(seed,n,L,skew,restart); break;
+        case 12: run<12>(seed,n,L,skew,restart); break;
+        case 13: run<13>(seed,n,L,skew,restart); break;
+        case 14: run<14>(seed,n,L,skew,restart); break;
+        case 15: run<15>(seed,n,L,skew,restart); break;
+        case 16: run<16>(seed,n,L,skew,restart); break;
+        case 17: run<17>(seed,n,L,skew,restart); break;
+        case 18: run<18>(seed,n,L,skew,restart); break;
+        case 19: run<19>(seed,n,L,skew,restart); break;
+        case 20: run<20>(seed,n,L,skew,restart); break;
+        case 513: run<513>(seed,n,L,skew,restart); break;
+        default: run<0>(seed,n,L,skew,restart);
+        }
+    }
+    catch (string err) {
+        cerr<<err<<std::endl;
+        return 1;
+    }
+
+    return 0;
+}
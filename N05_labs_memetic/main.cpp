@@ -0,0 +1,561 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <vector>
+#include <array>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+using namespace std::chrono;
+
+// Dolzina zaporedja: N>0 je znana ob prevajanju, N=0 pomeni dolzino ob izvajanju.
+template<size_t N> struct Length{
+    static constexpr size_t L = N;
+    Length(const size_t L){ if(L != N) throw string("Wrong sequence length!"); }
+};
+template<size_t N> constexpr size_t Length<N>::L;
+
+template<> struct Length<0>{
+    const size_t L;
+    Length(const size_t L): L(L) {}
+};
+
+// Polje s fiksno dolzino (std::array) ali vector, ce dolzina ni znana ob prevajanju.
+template<class T, size_t N> struct Buffer: array<T,N>{
+    Buffer(const size_t, const T v){ this->fill(v); }
+};
+
+template<class T> struct Buffer<T,0>: vector<T>{
+    Buffer(const size_t n, const T v): vector<T>(n,v) {}
+};
+
+template<size_t N> struct Walk;
+
+// Skew-simetricno zaporedje lihe dolzine L=2m-1 ima s[m-1+j] = (-1)^j s[m-1-j].
+// Vsi lihi c[k] so 0, zato racunamo le sode zamike. Prostih elementov je m, poteza
+// i < m-1 zamenja s[i] in zrcalni s[L-1-i] hkrati, poteza m-1 pa sredinski element.
+template<size_t N=0>
+class LABS: Length<N>{
+public:
+    enum value { p=+1, n=-1};
+    typedef Buffer<int,N> ints;
+    LABS(const size_t L, const bool skew=false): Length<N>(L), skew(skew), seq(L,p), c(L,0), tail(L+1,0), peak(L+1,0),
+          e(numeric_limits<int>::max()), psl(numeric_limits<int>::max()) {
+        if(skew && L%2 == 0) throw string("Skew-symmetric sequences need odd length!");
+    };
+    LABS(const LABS & l): Length<N>(l.L), skew(l.skew), seq(l.seq), c(l.c), tail(l.tail), peak(l.peak), e(l.e), psl(l.psl) {}
+    LABS& operator=(const LABS & l);
+    inline double get_mf() const { return (L*L)/(2.0*e); }
+    inline int get_e() const { return e; }
+    inline int get_psl() const { return psl; }
+    inline size_t moves() const { return skew ? (L+1)/2 : L; }
+    void random(mt19937 & rand);
+    void evaluate_e();
+    void evaluate_psl();
+    int neighbor_e(const size_t n) const;
+    void neighborhood_e(ints & ne, Buffer<int,3*N> & f, Buffer<int,3*N> & b) const;
+    int neighbor_psl(const size_t n) const;
+    void update_e(const size_t n, const int e);
+    void update_psl(const size_t n, const int psl);
+    inline void get(value s[]) const { copy(seq.begin(), seq.end(), s); }
+    // V skew nacinu se uporabi le prvih moves() elementov s, ostale dopolni mirror.
+    inline void set(const value s[]) { copy(s, s+L, seq.begin()); mirror(); }
+    bool in_pool(const vector<value> & pool, const vector<int> & fit, const int f) const;
+    void tabu_e(const size_t walkLmt, Walk<N> & w, mt19937 & rand, size_t & nfes);
+    void tabu_psl(const size_t walkLmt, Walk<N> & w, mt19937 & rand, size_t & nfes);
+    static LABS memetic_search_e(const size_t seed, const size_t n, const size_t L, const bool skew=false);
+    static LABS memetic_search_psl(const size_t seed, const size_t n, const size_t L, const bool skew=false);
+
+private:
+    void mirror();
+    int skew_delta(const size_t i, const size_t k) const;
+    void skew_neighborhood_e(ints & ne, Buffer<int,3*N> & f, Buffer<int,3*N> & b) const;
+    void check_skew() const;
+    using Length<N>::L;
+    bool skew;
+    Buffer<value,N> seq;
+    ints c;
+    Buffer<int,N ? N+1 : 0> tail; // tail[k] = sum c[j]^2 za j>=k, velja po evaluate_e in update_e
+    Buffer<int,N ? N+1 : 0> peak; // peak[k] = max |c[j]| za j>=k, velja po evaluate_psl in update_psl
+    int e, psl;
+};
+
+// Delovni prostor tabu iskanja. Uporabimo ga za vse potomce, zato lokalno iskanje
+// ne alocira: tudi pri LABS<0> prirejanja le prepisejo obstojece vektorje.
+template<size_t N>
+struct Walk{
+    Walk(const size_t L, const bool skew): best(L,skew), tabu(L,0), ne(L,0), f(3*L,0), b(3*L,0) {}
+    LABS<N> best; // najboljse zaporedje sprehoda
+    Buffer<size_t,N> tabu; // tabu[i] = prvi korak, v katerem je i spet dovoljen
+    typename LABS<N>::ints ne;
+    Buffer<int,3*N> f, b; // f[L+j] = s[j], b[L+j] = s[L-1-j], robovi so 0
+};
+
+template<size_t N>
+LABS<N>& LABS<N>::operator=(const LABS & l){
+    if(L != l.L) throw std::string("Sequences with diferent length!");
+    skew=l.skew; seq=l.seq; c=l.c; tail=l.tail; peak=l.peak; e=l.e; psl=l.psl; return *this;
+}
+
+template<size_t N>
+void LABS<N>::random(mt19937 & rand){
+    // En klic generatorja da 32 nakljucnih elementov.
+    for(size_t i=0; i<moves(); i+=32){
+        const uint32_t w = rand();
+        for(size_t j=i; j<min(moves(), i+32); j++) seq[j] = (w>>(j-i))&1 ? p : n;
+    }
+    mirror();
+}
+
+// Pri skew-simetricnem zaporedju iz prostih elementov dopolni zrcalne.
+template<size_t N>
+void LABS<N>::mirror(){
+    if(!skew) return;
+    const size_t m = moves();
+    for(size_t i=0; i+1<m; i++) seq[L-1-i] = (m-1-i)%2 ? (value)(-seq[i]) : seq[i];
+}
+
+template<size_t N>
+void LABS<N>::evaluate_e(){
+    const size_t step = skew ? 2 : 1;
+    for (size_t k=1; k<L; k++) c[k]=0;
+    for (size_t k=step; k<L; k+=step) {
+        for (size_t i=0; i<=L-k-1; i++) c[k] += seq[i]*seq[i+k];
+    }
+    #ifndef NDEBUG
+    check_skew();
+    #endif
+    tail[L] = 0;
+    for (size_t k=L-1; k>=1; k--) tail[k] = tail[k+1] + c[k]*c[k];
+    e = tail[1];
+}
+
+template<size_t N>
+void LABS<N>::evaluate_psl(){
+    const size_t step = skew ? 2 : 1;
+    for (size_t k=1; k<L; k++) c[k]=0;
+    for (size_t k=step; k<L; k+=step) {
+        for (size_t i=0; i<=L-k-1; i++) c[k] += seq[i]*seq[i+k];
+    }
+    #ifndef NDEBUG
+    check_skew();
+    #endif
+    peak[L] = 0;
+    for (size_t k=L-1; k>=1; k--) peak[k] = max(peak[k+1], abs(c[k]));
+    psl = peak[1];
+}
+
+// Preveri, da so lihi c[k] res 0, ker jih skew-simetricne funkcije ne racunajo.
+template<size_t N>
+void LABS<N>::check_skew() const{
+    if(!skew) return;
+    for (size_t k=1; k<L; k+=2){
+        int ck = 0;
+        for (size_t i=0; i<=L-k-1; i++) ck += seq[i]*seq[i+k];
+        if(ck) throw string("Sequence is not skew-symmetric!");
+    }
+}
+
+// Za koliko se zmanjsa c[k]/2 (k sod), ce hkrati zamenjamo s[i] in zrcalni s[m], m = L-1-i.
+// Pri sodem k je s[m]*(s[m+k] + s[m-k]) = s[i]*(s[i-k] + s[i+k]), zato zrcalni element
+// le podvoji prispevek s[i]. Produkt s[i]*s[m] pri k = m-i ostane enak.
+template<size_t N>
+int LABS<N>::skew_delta(const size_t i, const size_t k) const{
+    const size_t m = L-1-i;
+    int d = 0;
+    if(i+k<L) d += seq[i]*seq[k+i];
+    if(k<=i) d += seq[i-k]*seq[i];
+    if(m != i){
+        d *= 2;
+        if(k == m-i) d -= 2*seq[i]*seq[m];
+    }
+    return d;
+}
+
+template<size_t N>
+int LABS<N>::neighbor_e(const size_t i) const{
+    int e = 0, ck;
+    const size_t lmt = std::max(L-i,i+1);
+    size_t k=1;
+    if(skew){
+        for(k=2; k<lmt; k+=2){
+            ck = c[k] - 2*skew_delta(i,k);
+            e += ck*ck;
+        }
+        return e + tail[min(k,L)];
+    }
+    for(;k<lmt; k++) {
+        ck = c[k];
+        if(i+k<L) ck -= 2*seq[i]*seq[k+i];
+        if(k<=i) ck -= 2*seq[i-k]*seq[i];
+        e += ck*ck;
+    }
+    return e + tail[k];
+}
+
+// Energije vseh L sosedov v enem prehodu. Po zamenjavi s[i] je
+// c'[k] = c[k] - 2*s[i]*d[k], d[k] = s[i+k] + s[i-k], zato je
+// E' = E + 4*(sum d[k]^2 - s[i]*sum c[k]*d[k]). Elementi izven zaporedja so 0,
+// tako da notranja zanka nima pogojev. f in b (dolzine 3L, robovi 0) poda klicoci.
+template<size_t N>
+void LABS<N>::neighborhood_e(ints & ne, Buffer<int,3*N> & f, Buffer<int,3*N> & b) const{
+    if(skew) return skew_neighborhood_e(ne, f, b);
+    for(size_t j=0; j<L; j++){
+        f[L+j] = seq[j];
+        b[2*L-1-j] = seq[j];
+    }
+    for(size_t i=0; i<L; i++){
+        const int *fi = &f[L+i], *bi = &b[2*L-1-i]; // fi[k] = s[i+k], bi[k] = s[i-k]
+        int cd = 0, dd = 0;
+        for(size_t k=1; k<L; k++){
+            const int d = fi[k] + bi[k];
+            cd += c[k]*d;
+            dd += d*d;
+        }
+        ne[i] = e + 4*(dd - seq[i]*cd);
+        #ifndef NDEBUG
+        if(ne[i] != neighbor_e(i)) throw string("Wrong neighborhood E!");
+        #endif
+    }
+}
+
+// Enako kot neighborhood_e, le da tecemo po sodih k in je d[k] zaradi zrcalnega
+// elementa podvojen (glej skew_delta). Popravek za s[i]*s[m] pristejemo po zanki.
+template<size_t N>
+void LABS<N>::skew_neighborhood_e(ints & ne, Buffer<int,3*N> & f, Buffer<int,3*N> & b) const{
+    for(size_t j=0; j<L; j++){
+        f[L+j] = seq[j];
+        b[2*L-1-j] = seq[j];
+    }
+    for(size_t i=0; i<moves(); i++){
+        const size_t m = L-1-i;
+        const int w = m != i ? 2 : 1;
+        const int *fi = &f[L+i], *bi = &b[2*L-1-i];
+        int cd = 0, dd = 0;
+        for(size_t k=2; k<L; k+=2){
+            const int d = w*(fi[k] + bi[k]);
+            cd += c[k]*d;
+            dd += d*d;
+        }
+        ne[i] = e + 4*(dd - seq[i]*cd);
+        if(m != i){
+            const size_t k = m-i;
+            const int d = seq[i]*w*(fi[k] + bi[k]), x = 2*seq[i]*seq[m];
+            ne[i] += 4*(x*x - 2*x*d + c[k]*x);
+        }
+        #ifndef NDEBUG
+        if(ne[i] != neighbor_e(i)) throw string("Wrong neighborhood E!");
+        #endif
+    }
+}
+
+template<size_t N>
+int LABS<N>::neighbor_psl(const size_t i) const{
+    int psl = 0, ck;
+    const size_t lmt = max(L-i,i+1);
+    size_t k=1;
+    if(skew){
+        for(k=2; k<lmt; k+=2){
+            ck = c[k] - 2*skew_delta(i,k);
+            if(abs(ck) > psl) psl = abs(ck);
+        }
+        return max(psl, peak[min(k,L)]);
+    }
+    for(; k<lmt; k++) {
+        ck = c[k];
+        if(i+k<L) ck -= 2*seq[i]*seq[k+i];
+        if(k<=i) ck -= 2*seq[i-k]*seq[i];
+        if(abs(ck) > psl) psl = abs(ck);
+    }
+    return max(psl, peak[k]);
+}
+
+template<size_t N>
+void LABS<N>::update_e(const size_t i, const int e){
+    const size_t lmt = max(L-i,i+1);
+    size_t k=1;
+    if(skew) for (k=2; k<lmt; k+=2) c[k] -= 2*skew_delta(i,k);
+    else for (;k<lmt; k++){
+        int ck = c[k];
+        if(i+k<L) ck -= 2*seq[i]*seq[k+i];
+        if(k<=i) ck -= 2*seq[i-k]*seq[i];
+        c[k] = ck;
+    }
+    for (k=lmt-1; k>=1; k--) tail[k] = tail[k+1] + c[k]*c[k];
+    this->e = e;
+    seq[i] = (value)(-seq[i]);
+    if(skew && L-1-i != i) seq[L-1-i] = (value)(-seq[L-1-i]);
+    #ifndef NDEBUG
+    int update_e = e;
+    auto update_tail = tail;
+    evaluate_e();
+    if(e != update_e || tail != update_tail) throw string("Wrong E!");
+    #endif
+}
+
+template<size_t N>
+void LABS<N>::update_psl(const size_t i, const int psl){
+    const size_t lmt = max(L-i,i+1);
+    size_t k=1;
+    int ck;
+    if(skew) for (k=2; k<lmt; k+=2) c[k] -= 2*skew_delta(i,k);
+    else for (; k<lmt; k++){
+        ck = c[k];
+        if(i+k<L) ck -= 2*seq[i]*seq[k+i];
+        if(k<=i) ck -= 2*seq[i-k]*seq[i];
+        c[k] = ck;
+    }
+    for (k=lmt-1; k>=1; k--) peak[k] = max(peak[k+1], abs(c[k]));
+    this->psl = psl;
+    seq[i] = (value)(-seq[i]);
+    if(skew && L-1-i != i) seq[L-1-i] = (value)(-seq[L-1-i]);
+    #ifndef NDEBUG
+    int update_psl = psl;
+    auto update_peak = peak;
+    evaluate_psl();
+    if(psl != update_psl || peak != update_peak) throw string("Wrong PSL!");
+    #endif
+}
+
+// Kratko tabu iskanje iz trenutnega zaporedja: vedno naredimo najboljso dovoljeno
+// zamenjavo, zamenjan element je nato tabu minTenure + rand()%extraTenure korakov,
+// razen ce bi zamenjava izboljsala najboljso resitev sprehoda (aspiracija).
+// Na koncu je *this najboljse zaporedje sprehoda.
+template<size_t N>
+void LABS<N>::tabu_e(const size_t walkLmt, Walk<N> & w, mt19937 & rand, size_t & nfes){
+    LABS & best = w.best;
+    best = *this;
+    const size_t M = moves(); // stevilo sosedov, v skew nacinu (L+1)/2
+    const size_t minTenure = max<size_t>(1,M/10), extraTenure = max<size_t>(1,M/10);
+    size_t best_neighbor;
+    int best_neighbor_e;
+    ints & ne = w.ne;
+    auto & tabu = w.tabu;
+    fill(tabu.begin(), tabu.end(), 0);
+    for(size_t step=0; step<walkLmt; step++){
+        neighborhood_e(ne, w.f, w.b);
+        nfes+=M;
+        best_neighbor = M;
+        best_neighbor_e = numeric_limits<int>::max();
+        for(size_t i=0; i<M; i++){
+            if((tabu[i] <= step || ne[i] < best.e) && ne[i] < best_neighbor_e){
+                best_neighbor = i;
+                best_neighbor_e = ne[i];
+            }
+        }
+        if(best_neighbor == M) break;
+        update_e(best_neighbor,best_neighbor_e);
+        tabu[best_neighbor] = step + minTenure + rand()%extraTenure;
+        if(e < best.e) best = *this;
+    }
+    *this = best;
+}
+
+template<size_t N>
+void LABS<N>::tabu_psl(const size_t walkLmt, Walk<N> & w, mt19937 & rand, size_t & nfes){
+    LABS & best = w.best;
+    best = *this;
+    const size_t M = moves(); // stevilo sosedov, v skew nacinu (L+1)/2
+    const size_t minTenure = max<size_t>(1,M/10), extraTenure = max<size_t>(1,M/10);
+    size_t best_neighbor;
+    int best_neighbor_psl, psl;
+    auto & tabu = w.tabu;
+    fill(tabu.begin(), tabu.end(), 0);
+    for(size_t step=0; step<walkLmt; step++){
+        best_neighbor = M;
+        best_neighbor_psl = numeric_limits<int>::max();
+        for(size_t i=0; i<M; i++){
+            psl = neighbor_psl(i);
+            if((tabu[i] <= step || psl < best.psl) && psl < best_neighbor_psl){
+                best_neighbor = i;
+                best_neighbor_psl = psl;
+            }
+        }
+        nfes+=M;
+        if(best_neighbor == M) break;
+        update_psl(best_neighbor,best_neighbor_psl);
+        tabu[best_neighbor] = step + minTenure + rand()%extraTenure;
+        if(this->psl < best.psl) best = *this;
+    }
+    *this = best;
+}
+
+// Ali je zaporedje ze v populaciji; primerjamo le zaporedja z enako oceno f.
+template<size_t N>
+bool LABS<N>::in_pool(const vector<value> & pool, const vector<int> & fit, const int f) const{
+    for(size_t j=0; j<fit.size(); j++){
+        if(fit[j] == f && equal(seq.begin(), seq.end(), pool.begin()+j*L)) return true;
+    }
+    return false;
+}
+
+// Memetski algoritem (po Gallardo in dr.): populacija popSize zaporedij, vsak
+// potomec nastane z binarnim turnirjem, enakomernim krizanjem (verjetnost 0.9)
+// in mutacijo (verjetnost 1/M na element) ter ga izboljsamo s kratkim tabu
+// iskanjem dolzine L/2 do 3L/2. Potomec zamenja najslabsega v populaciji, ce je
+// boljsi od njega in ga v populaciji se ni. Zaporedja populacije so v enem zveznem bloku pool, zaporedje
+// j je pool[j*L .. j*L+L), njegova ocena je fit[j]. Krizanje in mutacija delujeta na
+// M = moves() prostih elementih; v skew nacinu zrcalne dopolni set.
+template<size_t N>
+LABS<N> LABS<N>::memetic_search_e(const size_t seed, const size_t n, const size_t L, const bool skew){
+    LABS current(L,skew), best(L,skew);
+    Walk<N> walk(L,skew);
+    const size_t M = current.moves(); // prosti elementi, v skew nacinu (L+1)/2
+    mt19937 rand(seed);
+    const size_t popSize = 20;
+    vector<value> pool(popSize*L), child(L);
+    vector<int> fit(popSize);
+    size_t nfes=0;
+    for(size_t j=0; j<popSize && nfes<n; j++){
+        current.random(rand);
+        current.evaluate_e();
+        nfes++;
+        current.tabu_e(L/2 + rand()%(L+1), walk, rand, nfes);
+        current.get(&pool[j*L]);
+        fit[j] = current.get_e();
+        if(current.get_e() < best.get_e()) best = current;
+    }
+    uniform_real_distribution<double> prob(0,1);
+    auto tournament = [&](){
+        const size_t a = rand()%popSize, b = rand()%popSize;
+        return fit[a] <= fit[b] ? a : b;
+    };
+    while(nfes < n){
+        const value *p1 = &pool[tournament()*L], *p2 = &pool[tournament()*L];
+        if(prob(rand) < 0.9){
+            for(size_t i=0; i<M; i+=32){
+                const uint32_t w = rand();
+                for(size_t j=i; j<min(M, i+32); j++) child[j] = (w>>(j-i))&1 ? p1[j] : p2[j];
+            }
+        }
+        else copy(p1, p1+L, child.begin());
+        for(size_t i=0; i<M; i++){
+            if(prob(rand) < 1.0/M) child[i] = (value)(-child[i]);
+        }
+        current.set(child.data());
+        current.evaluate_e();
+        nfes++;
+        current.tabu_e(L/2 + rand()%(L+1), walk, rand, nfes);
+        if(current.get_e() < best.get_e()) best = current;
+        const size_t worst = max_element(fit.begin(), fit.end()) - fit.begin();
+        if(current.get_e() < fit[worst] && !current.in_pool(pool, fit, current.get_e())){
+            current.get(&pool[worst*L]);
+            fit[worst] = current.get_e();
+        }
+    }
+    return best;
+}
+
+template<size_t N>
+LABS<N> LABS<N>::memetic_search_psl(const size_t seed, const size_t n, const size_t L, const bool skew){
+    LABS current(L,skew), best(L,skew);
+    Walk<N> walk(L,skew);
+    const size_t M = current.moves(); // prosti elementi, v skew nacinu (L+1)/2
+    mt19937 rand(seed);
+    const size_t popSize = 20;
+    vector<value> pool(popSize*L), child(L);
+    vector<int> fit(popSize);
+    size_t nfes=0;
+    for(size_t j=0; j<popSize && nfes<n; j++){
+        current.random(rand);
+        current.evaluate_psl();
+        nfes++;
+        current.tabu_psl(L/2 + rand()%(L+1), walk, rand, nfes);
+        current.get(&pool[j*L]);
+        fit[j] = current.get_psl();
+        if(current.get_psl() < best.get_psl()) best = current;
+    }
+    uniform_real_distribution<double> prob(0,1);
+    auto tournament = [&](){
+        const size_t a = rand()%popSize, b = rand()%popSize;
+        return fit[a] <= fit[b] ? a : b;
+    };
+    while(nfes < n){
+        const value *p1 = &pool[tournament()*L], *p2 = &pool[tournament()*L];
+        if(prob(rand) < 0.9){
+            for(size_t i=0; i<M; i+=32){
+                const uint32_t w = rand();
+                for(size_t j=i; j<min(M, i+32); j++) child[j] = (w>>(j-i))&1 ? p1[j] : p2[j];
+            }
+        }
+        else copy(p1, p1+L, child.begin());
+        for(size_t i=0; i<M; i++){
+            if(prob(rand) < 1.0/M) child[i] = (value)(-child[i]);
+        }
+        current.set(child.data());
+        current.evaluate_psl();
+        nfes++;
+        current.tabu_psl(L/2 + rand()%(L+1), walk, rand, nfes);
+        if(current.get_psl() < best.get_psl()) best = current;
+        const size_t worst = max_element(fit.begin(), fit.end()) - fit.begin();
+        if(current.get_psl() < fit[worst] && !current.in_pool(pool, fit, current.get_psl())){
+            current.get(&pool[worst*L]);
+            fit[worst] = current.get_psl();
+        }
+    }
+    return best;
+}
+
+template<size_t N>
+void run(const size_t seed, const size_t n, const size_t L, const bool skew){
+    cout<<"Searching ..."<<endl;
+    auto start = system_clock::now();
+    LABS<N> best = LABS<N>::memetic_search_e(seed,n,L,skew);
+    auto end = system_clock::now();
+    auto elapsed = duration_cast<milliseconds>(end - start);
+    cout<<"E: "<<best.get_e()<<" F: "<<best.get_mf();
+    cout<<" speed: "<<n/(elapsed.count()/1000.0)<<" eval/sec"<<endl;
+
+    cout<<"Searching ..."<<endl;
+    start = system_clock::now();
+    best = LABS<N>::memetic_search_psl(seed,n,L,skew);
+    end = system_clock::now();
+    elapsed = duration_cast<milliseconds>(end - start);
+    cout<<"PSL: "<<best.get_psl();
+    cout<<" speed: "<<n/(elapsed.count()/1000.0)<<" eval/sec"<<endl;
+}
+
+int main(int argc, char *argv[]){
+    try{
+        if(argc < 4) throw string("Three arguments are required!");
+
+        const size_t seed =atoi(argv[1]), n = atoi(argv[2]), L = atoi(argv[3]);
+        // Dodatni argument "skew" omeji iskanje na skew-simetricna zaporedja lihe dolzine.
+        bool skew = false;
+        for(int a=4; a<argc; a++){
+            const string arg = argv[a];
+            if(arg == "skew") skew = true;
+            else throw string("Unknown argument: ") + arg;
+        }
+        // Pogoste dolzine so prevedene s konstantno dolzino, ostale tecejo z LABS<0>
+        switch(L){
+        case 4: run<4>(seed,n,L,skew); break;
+        case 5: run<5>(seed,n,L,skew); break;
+        case 6: run<6>(seed,n,L,skew); break;
+        case 7: run<7>(seed,n,L,skew); break;
+        case 8: run<8>(seed,n,L,skew); break;
+        case 9: run<9>(seed,n,L,skew); break;
+        case 10: run<10>(seed,n,L,skew); break;
+        case 11: run<11>(seed,n,L,skew); break;
+        case 12: run<12>(seed,n,L,skew); break;
+        case 13: run<13>(seed,n,L,skew); break;
+        case 14: run<14>(seed,n,L,skew); break;
+        case 15: run<15>(seed,n,L,skew); break;
+        case 16: run<16>(seed,n,L,skew); break;
+        case 17: run<17>(seed,n,L,skew); break;
+        case 18: run<18>(seed,n,L,skew); break;
+        case 19: run<19>(seed,n,L,skew); break;
+        case 20: run<20>(seed,n,L,skew); break;
+        case 513: run<513>(seed,n,L,skew); break;
+        default: run<0>(seed,n,L,skew);
+        }
+    }
+    catch (string err) {
+        cerr<<err<<std::endl;
+        return 1;
+    }
+
+    return 0;
+}
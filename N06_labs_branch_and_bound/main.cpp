@@ -0,0 +1,178 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+using namespace std;
+using namespace std::chrono;
+
+// Eksaktno iskanje z razveji in omeji. Elemente dolocamo izmenicno z obeh koncev
+// (0, L-1, 1, L-2, ...), zato so po m dolocenih parih vsi c[k] za k >= L-m znani.
+// Za ostale c[k] poznamo delno vsoto p[k] znanih produktov in stevilo u neznanih.
+// Nedolocen x[j], ki ima oba soseda s[j-k] in s[j+k] dolocena in nasprotnega
+// predznaka, k c[k] prispeva x[j]*(s[j-k]+s[j+k]) = 0; takih je z[k], zato je
+// |c[k]| >= max(|p[k]| - r[k], (L-k)%2), kjer je r[k] = u - 2 z[k].
+// Vsota kvadratov (E) oz. maksimum (PSL) teh mej je spodnja meja za vse
+// dokoncanja in z njo obrezujemo veje. Na vsaki globini hranimo svojo kopijo
+// p in r ter popravimo le c[k], ki jih dolocitev elementa spremeni.
+// Simetrije negacije, izmenicne negacije (s[i] -> (-1)^i s[i]) in obrata prekinemo:
+// s[0] = s[1] = +1 in zaporedje ni leksikografsko vecje od svoje slike
+// T(s)[i] = s[L-1] b^i s[L-1-i], b = s[L-1] s[L-2] (obrat, po potrebi negiran, da
+// je tudi T(s)[0] = T(s)[1] = +1).
+class BranchAndBound{
+public:
+    // incumbent je znana zgornja meja (npr. iz hevristike); iscemo zaporedje z E oz. PSL <= incumbent
+    BranchAndBound(const size_t L, const bool psl, const int incumbent=numeric_limits<int>::max()-1):
+          L(L), psl(psl), s(L,0), pos(L), p((L+1)*L,0), r((L+1)*L,0),
+          sum(L+1,0), over(L+1,0), best(incumbent+1), best_seq(), nodes(0) {
+        for(size_t d=0; d<L; d++) pos[d] = d%2 ? L-1-d/2 : d/2;
+        for(size_t k=1; k<L; k++){
+            r[k] = L-k;
+            sum[0] += lower(0, k)*lower(0, k);
+            over[0] += lower(0, k) >= best;
+        }
+    }
+    inline int get_best() const { return best; }
+    inline const vector<int> & get_best_seq() const { return best_seq; }
+    inline bool found() const { return !best_seq.empty(); }
+    inline size_t get_nodes() const { return nodes; }
+    void solve(){ branch(0, true); }
+
+private:
+    inline int lower(const size_t d, const size_t k) const { return max(abs(p[d*L+k]) - r[d*L+k], (int)((L-k)%2)); }
+    void change(const size_t d, const size_t k, const int dp, const int dr);
+    void assign(const size_t d, const int v);
+    void branch(const size_t d, const bool eq);
+    const size_t L;
+    const bool psl;
+    vector<int> s; // 0 pomeni se nedoloceno
+    vector<size_t> pos; // pos[d] = element, ki ga dolocimo na globini d
+    vector<int> p, r; // za globino d sta delna vsota in preostala svoboda za c[k] na [d*L+k]
+    vector<int> sum, over; // E: vsota kvadratov mej, PSL: stevilo mej >= best
+    int best;
+    vector<int> best_seq;
+    size_t nodes;
+};
+
+// Na globini d p[k] poveca za dp in r[k] za dr ter popravi sum oz. over
+inline void BranchAndBound::change(const size_t d, const size_t k, const int dp, const int dr){
+    const int b0 = lower(d, k);
+    p[d*L+k] += dp;
+    r[d*L+k] += dr;
+    const int b = lower(d, k);
+    if(psl) over[d] += (b >= best) - (b0 >= best);
+    else sum[d] += b*b - b0*b0;
+}
+
+// Stanje globine d prepise na globino d+1 in doloci s[pos[d]] = v. Nedoloceni
+// elementi so strnjeni v [lo, hi] in j = pos[d] je eno od krajisc, zato se z[k]
+// spremeni le za k, pri katerih sta j-k in j+k (ali x = j+-k in x+-k) zunaj [lo, hi].
+void BranchAndBound::assign(const size_t d, const int v){
+    const size_t j = pos[d], lo = (d+1)/2, hi = L-1-d/2, e = d+1;
+    copy(p.begin()+d*L, p.begin()+e*L, p.begin()+e*L);
+    copy(r.begin()+d*L, r.begin()+e*L, r.begin()+e*L);
+    sum[e] = sum[d];
+    over[e] = over[d];
+    // j ni vec nedolocen: odstrani njegove nicelne prispevke
+    for(size_t k=max(j-lo, hi-j)+1; k<=j && j+k<L; k++){
+        if(s[j-k] == -s[j+k]) change(e, k, 0, 2);
+    }
+    for(size_t t=0; t<d; t++){
+        const size_t a = pos[t], k = a > j ? a-j : j-a;
+        change(e, k, v*s[a], -1);
+    }
+    // j kot sosed nedolocenega x = j+-k, katerega drugi sosed je j+-2k
+    for(size_t k=(hi-j)/2+1; k<=hi-j && j+2*k<L; k++){
+        if(s[j+2*k] == -v) change(e, k, 0, -2);
+    }
+    for(size_t k=(j-lo)/2+1; k<=j-lo && 2*k<=j; k++){
+        if(s[j-2*k] == -v) change(e, k, 0, -2);
+    }
+    s[j] = v;
+}
+
+// eq pove, ali je dolocen del zaporedja do zdaj enak svoji sliki T.
+void BranchAndBound::branch(const size_t d, const bool eq){
+    nodes++;
+    if(psl ? over[d] > 0 : sum[d] >= best) return;
+    if(d == L){
+        // vsi c[k] so znani, meje so natancne
+        if(psl){
+            best = 0;
+            for(size_t k=1; k<L; k++) best = max(best, lower(d, k));
+            // over je odvisen od best, zato ga popravimo na vseh globinah
+            for(size_t e=0; e<=L; e++){
+                over[e] = 0;
+                for(size_t k=1; k<L; k++) over[e] += lower(e, k) >= best;
+            }
+        }
+        else best = sum[d];
+        best_seq = s;
+        #ifndef NDEBUG
+        int check = 0;
+        for(size_t k=1; k<L; k++){
+            int ck = 0;
+            for(size_t i=0; i+k<L; i++) ck += s[i]*s[i+k];
+            if(psl) check = max(check, abs(ck));
+            else check += ck*ck;
+        }
+        if(check != best) throw string(psl ? "Wrong PSL!" : "Wrong E!");
+        #endif
+        return;
+    }
+    const size_t j = pos[d], i = min(j, L-1-j);
+    for(int v=+1; v>=-1; v-=2){
+        if(j <= 1 && v == -1) break; // negacija: s[0] = +1, izmenicna negacija: s[1] = +1
+        assign(d, v);
+        bool ok = true, next_eq = eq;
+        if(eq && i > 0 && s[i] && s[L-1-i]){ // par i je dolocen
+            const int t = s[L-1]*s[L-1-i]*(i%2 ? s[L-1]*s[L-2] : 1);
+            if(s[i] > t) ok = false; // T(s) je leksikografsko manjsi, to vejo pokrije T(s)
+            else if(s[i] < t) next_eq = false;
+        }
+        if(ok) branch(d+1, next_eq);
+        s[j] = 0;
+    }
+}
+
+int main(int argc, char *argv[]){
+    try{
+        if(argc < 2) throw string("One argument is required!");
+
+        const size_t L = atoi(argv[1]);
+        if(L < 2) throw string("Sequence length must be at least 2!");
+        // Neobvezna argumenta e=K in psl=K podata zgornjo mejo (npr. rezultat hevristike),
+        // ki ze na zacetku obreze vse veje, slabse od K
+        int incumbent[2] = {numeric_limits<int>::max()-1, numeric_limits<int>::max()-1};
+        for(int a=2; a<argc; a++){
+            const string arg = argv[a];
+            if(arg.compare(0, 2, "e=") == 0) incumbent[0] = atoi(arg.c_str()+2);
+            else if(arg.compare(0, 4, "psl=") == 0) incumbent[1] = atoi(arg.c_str()+4);
+            else throw string("Unknown argument ")+arg+"!";
+        }
+        for(int psl=0; psl<2; psl++){
+            cout<<"Searching ..."<<endl;
+            auto start = system_clock::now();
+            BranchAndBound bnb(L, psl, incumbent[psl]);
+            bnb.solve();
+            auto end = system_clock::now();
+            auto elapsed = duration_cast<milliseconds>(end - start);
+            if(!bnb.found()) throw string(psl ? "No sequence with PSL <= " : "No sequence with E <= ")+to_string(incumbent[psl])+"!";
+            if(psl) cout<<"PSL: "<<bnb.get_best();
+            else cout<<"E: "<<bnb.get_best()<<" F: "<<(L*L)/(2.0*bnb.get_best());
+            cout<<" nodes: "<<bnb.get_nodes();
+            cout<<" speed: "<<bnb.get_nodes()/max(elapsed.count()/1000.0, 0.001)<<" nodes/sec"<<endl;
+            cout<<"Sequence: ";
+            for(const int v: bnb.get_best_seq()) cout<<(v > 0 ? '+' : '-');
+            cout<<endl;
+        }
+    }
+    catch (string err) {
+        cerr<<err<<std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -2,221 +2,1146 @@
 #include <random>
 #include <chrono>
 #include <vector>
+#include <array>
 #include <limits>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <deque>
+#include <cstdint>
 
 using namespace std;
 using namespace std::chrono;
 
-class LABS{
+// Dolzina zaporedja: N>0 je znana ob prevajanju, N=0 pomeni dolzino ob izvajanju.
+template<size_t N> struct Length{
+    static constexpr size_t L = N;
+    Length(const size_t L){ if(L != N) throw string("Wrong sequence length!"); }
+};
+template<size_t N> constexpr size_t Length<N>::L;
+
+template<> struct Length<0>{
+    const size_t L;
+    Length(const size_t L): L(L) {}
+};
+
+// Polje s fiksno dolzino (std::array) ali vector, ce dolzina ni znana ob prevajanju.
+template<class T, size_t N> struct Buffer: array<T,N>{
+    Buffer(const size_t, const T v){ this->fill(v); }
+};
+
+template<class T> struct Buffer<T,0>: vector<T>{
+    Buffer(const size_t n, const T v): vector<T>(n,v) {}
+};
+
+// Ovira z vrtenjem: koraki so kratki (pri L=2000 nekaj milisekund na vse niti),
+// zato niti cakajo na atomarnem stevcu generacij namesto na pogojni spremenljivki.
+// Po nekaj obratih se umaknejo z yield, da ovira deluje tudi z vec nitmi kot jedri.
+class SpinBarrier{
+public:
+    SpinBarrier(const size_t n): n(n), count(0), generation(0) {}
+    void wait(){
+        const size_t gen = generation.load(memory_order_acquire);
+        if(count.fetch_add(1, memory_order_acq_rel) + 1 == n){
+            count.store(0, memory_order_relaxed);
+            generation.fetch_add(1, memory_order_release);
+            return;
+        }
+        for(size_t spins=0; generation.load(memory_order_acquire) == gen; spins++){
+            if(spins >= 1024) this_thread::yield();
+        }
+    }
+
+private:
+    const size_t n;
+    atomic<size_t> count, generation;
+};
+
+// Stalne delovne niti za delo znotraj enega koraka iskanja. run(task) izvede
+// task(w) na vseh size() nitih (klicoca nit je w=0) in se vrne, ko vse koncajo.
+class ThreadPool{
+public:
+    ThreadPool(const size_t workers): workers(workers), start(workers), done(workers), task(nullptr), stop(false) {
+        for(size_t w=1; w<workers; w++) threads.emplace_back(&ThreadPool::worker, this, w);
+    }
+    ~ThreadPool(){
+        stop = true;
+        start.wait();
+        for(thread & t: threads) t.join();
+    }
+    inline size_t size() const { return workers; }
+    void run(const function<void(size_t)> & task){
+        this->task = &task;
+        start.wait();
+        task(0);
+        done.wait();
+    }
+
+private:
+    void worker(const size_t w){
+        while(true){
+            start.wait(); // task in stop sta vidna po oviri
+            if(stop) return;
+            (*task)(w);
+            done.wait();
+        }
+    }
+    const size_t workers;
+    SpinBarrier start, done;
+    const function<void(size_t)> * task;
+    bool stop;
+    vector<thread> threads;
+};
+
+// Razporejevalnik s krajo dela. Vsaka nit ima svojo vrsto opravil in jemlje z njenega
+// zacetka; ko je prazna, ukrade polovico opravil s konca druge vrste. Opravilo je cel
+// zagon, zato so dostopi redki in zadostuje mutex na vrsto. Opravila delimo krozno,
+// da vse niti najprej vzamejo kratke zgodnje zagone in gredo opravila v narascajocem
+// vrstnem redu, kot pri zaporednem iskanju.
+class WorkStealing{
+public:
+    WorkStealing(const size_t workers, const size_t tasks): queues(workers) {
+        for(size_t t=0; t<tasks; t++) queues[t%workers].tasks.push_back(t);
+    }
+    bool pop(const size_t w, size_t & task);
+
+private:
+    struct Queue{
+        mutex m;
+        deque<size_t> tasks;
+    };
+    vector<Queue> queues;
+};
+
+bool WorkStealing::pop(const size_t w, size_t & task){
+    {
+        lock_guard<mutex> lock(queues[w].m);
+        if(!queues[w].tasks.empty()){
+            task = queues[w].tasks.front();
+            queues[w].tasks.pop_front();
+            return true;
+        }
+    }
+    for(size_t v=1; v<queues.size(); v++){
+        Queue & victim = queues[(w+v)%queues.size()];
+        deque<size_t> stolen;
+        {
+            lock_guard<mutex> lock(victim.m);
+            const size_t k = (victim.tasks.size()+1)/2;
+            stolen.assign(victim.tasks.end()-k, victim.tasks.end());
+            victim.tasks.erase(victim.tasks.end()-k, victim.tasks.end());
+        }
+        if(stolen.empty()) continue;
+        task = stolen.front();
+        lock_guard<mutex> lock(queues[w].m);
+        queues[w].tasks.insert(queues[w].tasks.end(), stolen.begin()+1, stolen.end());
+        return true;
+    }
+    return false;
+}
+
+// Najboljsi sosed dela, ki ga oceni ena nit; zapolnjen na 64 bajtov, da si
+// niti ne delijo predpomnilniske vrstice.
+struct Local{
+    size_t i;
+    int value;
+    char pad[64-sizeof(size_t)-sizeof(int)];
+};
+
+// Politika ponovnih zagonov. fixed zacne znova vsakih unit korakov, luby po
+// unit*luby(r) korakih, geometric po unit*1.5^r korakih (r je stevilo dosedanjih
+// zagonov), stagnation pa po unit korakih brez izboljsave v trenutnem zagonu.
+// perturb>0 pomeni delni zagon: namesto novega nakljucnega zaporedja zamenjamo
+// perturb nakljucnih elementov najboljse resitve, c[] pa popravimo inkrementalno.
+class Restart{
+public:
+    enum policy { fixed, luby, geometric, stagnation };
+    Restart(const policy type, const size_t unit, const size_t perturb):
+        type(type), unit(unit), perturb(perturb), restarts(0), steps(0), lmt(unit) {}
+    // Klicemo po vsakem koraku; vrne true, ko je cas za ponovni zagon.
+    bool step(const bool improved){
+        if(type == stagnation && improved) steps = 0;
+        if(++steps < lmt) return false;
+        steps = 0;
+        next();
+        return true;
+    }
+    // Stanje, kot da je bilo ze r ponovnih zagonov; tako ima neodvisno opravilo r
+    // enako dolzino kot r-ti zagon zaporednega iskanja.
+    void skip(const size_t r){
+        restarts = r;
+        steps = 0;
+        if(type == luby) lmt = unit*luby_seq(r+1);
+        else if(type == geometric) for(size_t i=0; i<r && lmt < numeric_limits<size_t>::max()/2; i++) lmt = lmt + lmt/2;
+    }
+    // Stevilo zagonov, ki jih zaporedno iskanje zacne v budget korakih. Pri stagnation
+    // traja zagon vsaj unit korakov, zato je to zgornja meja.
+    size_t runs(const size_t budget) const{
+        Restart r(type, unit, perturb);
+        size_t k = 1;
+        for(size_t total=r.lmt; total < budget; total+=r.lmt, k++) r.next();
+        return k;
+    }
+    inline size_t get_perturb() const { return perturb; }
+    static size_t luby_seq(const size_t i); // 1 1 2 1 1 2 4 1 1 2 ...
+
+private:
+    void next(){
+        restarts++;
+        if(type == luby) lmt = unit*luby_seq(restarts+1);
+        else if(type == geometric && lmt < numeric_limits<size_t>::max()/2) lmt = lmt + lmt/2;
+    }
+    const policy type;
+    const size_t unit, perturb;
+    size_t restarts, steps, lmt;
+};
+
+size_t Restart::luby_seq(const size_t i){
+    size_t k = 1;
+    while(((size_t)1<<k)-1 < i) k++;
+    if(i == ((size_t)1<<k)-1) return (size_t)1<<(k-1);
+    return luby_seq(i - ((size_t)1<<(k-1)) + 1);
+}
+
+// Skew-simetricno zaporedje lihe dolzine L=2m-1 ima s[m-1+j] = (-1)^j s[m-1-j].
+// Vsi lihi c[k] so 0, zato racunamo le sode zamike. Prostih elementov je m, poteza
+// i < m-1 zamenja s[i] in zrcalni s[L-1-i] hkrati, poteza m-1 pa sredinski element.
+template<size_t N> class Pareto;
+template<size_t N> class ElitePool;
+
+template<size_t N=0>
+class LABS: Length<N>{
 public:
     enum value { p=+1, n=-1};
-    LABS(const size_t L): L(L), seq(L,p), c(L,0),
-          e(numeric_limits<int>::max()), psl(numeric_limits<int>::max()) {};
-    LABS(const LABS & l): L(l.L), seq(l.seq), c(l.c), e(l.e), psl(l.psl) {}
+    typedef Buffer<int,N> ints;
+    LABS(const size_t L, const bool skew=false): Length<N>(L), skew(skew), seq(L,p), c(L,0), tail(L+1,0), peak(L+1,0),
+          e(numeric_limits<int>::max()), psl(numeric_limits<int>::max()) {
+        if(skew && L%2 == 0) throw string("Skew-symmetric sequences need odd length!");
+    };
+    LABS(const LABS & l): Length<N>(l.L), skew(l.skew), seq(l.seq), c(l.c), tail(l.tail), peak(l.peak), e(l.e), psl(l.psl) {}
     LABS& operator=(const LABS & l);
     inline double get_mf() const { return (L*L)/(2.0*e); }
     inline int get_e() const { return e; }
     inline int get_psl() const { return psl; }
+    inline size_t moves() const { return skew ? (L+1)/2 : L; }
     void random(mt19937 & rand);
+    void crossover(const LABS & l, mt19937 & rand);
+    void perturb_e(const size_t k, mt19937 & rand);
+    void perturb_psl(const size_t k, mt19937 & rand);
     void evaluate_e();
     void evaluate_psl();
+    void evaluate();
     int neighbor_e(const size_t n) const;
+    void neighborhood_e(ints & ne) const { neighborhood_e(ne, 0, moves()); }
+    void neighborhood_e(ints & ne, const size_t from, const size_t to) const;
     int neighbor_psl(const size_t n) const;
+    void neighbor(const size_t n, int & e, int & psl) const;
+    void neighborhood(ints & ne, ints & np) const;
     void update_e(const size_t n, const int e);
     void update_psl(const size_t n, const int psl);
-    static LABS steepest_descent_search_e(const size_t seed, const size_t n, const size_t L);
-    static LABS steepest_descent_search_psl(const size_t seed, const size_t n, const size_t L);
+    void update(const size_t n, const int e, const int psl);
+    static LABS steepest_descent_search_e(const size_t seed, const size_t n, const size_t L, const bool skew=false,
+                                          const Restart::policy policy=Restart::fixed, const size_t perturb=0,
+                                          ThreadPool * pool=nullptr);
+    static LABS steepest_descent_search_psl(const size_t seed, const size_t n, const size_t L, const bool skew=false,
+                                            const Restart::policy policy=Restart::fixed, const size_t perturb=0,
+                                            ThreadPool * pool=nullptr);
+    static LABS steepest_descent_tasks(const size_t seed, const size_t n, const size_t L, const bool skew,
+                                       const Restart::policy policy, ThreadPool & pool, const bool psl,
+                                       ElitePool<N> * elites=nullptr);
+    static Pareto<N> steepest_descent_search_pareto(const size_t seed, const size_t n, const size_t L, const bool skew=false,
+                                                    const Restart::policy policy=Restart::fixed, const size_t perturb=0);
 
 private:
-    const size_t L;
-    vector<value> seq;
-    vector<int> c;
+    friend class ElitePool<N>;
+    // Zobrist: prstni odtis je XOR zobrist(i) za vse i s seq[i] == n
+    static inline uint64_t zobrist(uint64_t i){
+        i = (i+1)*0x9e3779b97f4a7c15;
+        i = (i^(i>>30))*0xbf58476d1ce4e5b9;
+        i = (i^(i>>27))*0x94d049bb133111eb;
+        return i^(i>>31);
+    }
+    uint64_t fingerprint() const;
+    void mirror();
+    void correlate();
+    size_t flip(const size_t i);
+    int skew_delta(const size_t i, const size_t k) const;
+    void skew_neighborhood_e(ints & ne, const size_t from, const size_t to) const;
+    void check_skew() const;
+    using Length<N>::L;
+    bool skew;
+    Buffer<value,N> seq;
+    ints c;
+    Buffer<int,N ? N+1 : 0> tail; // tail[k] = sum c[j]^2 za j>=k, velja po evaluate_e, update_e in update
+    Buffer<int,N ? N+1 : 0> peak; // peak[k] = max |c[j]| za j>=k, velja po evaluate_psl, update_psl in update
     int e, psl;
 };
 
-LABS& LABS::operator=(const LABS & l){
+template<size_t N>
+uint64_t LABS<N>::fingerprint() const{
+    uint64_t h = 0;
+    for(size_t i=0; i<L; i++){
+        if(seq[i] == n) h ^= zobrist(i);
+    }
+    return h;
+}
+
+// Arhiv nedominiranih zaporedij po (E, PSL), urejen po narascajoci PSL in padajoci E.
+// Zaporedje z enakima E in PSL kot clan arhiva ne pride v arhiv.
+template<size_t N>
+class Pareto{
+public:
+    bool dominated(const int e, const int psl) const;
+    void insert(const LABS<N> & l);
+    inline const vector<LABS<N>> & get_front() const { return front; }
+    inline const LABS<N> & best_e() const { return front.back(); }
+    inline const LABS<N> & best_psl() const { return front.front(); }
+
+private:
+    vector<LABS<N>> front;
+};
+
+template<size_t N>
+bool Pareto<N>::dominated(const int e, const int psl) const{
+    for(const LABS<N> & m: front){
+        if(m.get_e() <= e && m.get_psl() <= psl) return true;
+    }
+    return false;
+}
+
+template<size_t N>
+void Pareto<N>::insert(const LABS<N> & l){
+    if(dominated(l.get_e(), l.get_psl())) return;
+    size_t j = 0;
+    for(size_t i=0; i<front.size(); i++){
+        if(front[i].get_e() >= l.get_e() && front[i].get_psl() >= l.get_psl()) continue;
+        if(j != i) front[j] = front[i];
+        j++;
+    }
+    front.erase(front.begin()+j, front.end());
+    size_t pos = 0;
+    while(pos < front.size() && front[pos].get_psl() < l.get_psl()) pos++;
+    front.insert(front.begin()+pos, l);
+}
+
+template<size_t N>
+LABS<N>& LABS<N>::operator=(const LABS & l){
     if(L != l.L) throw std::string("Sequences with diferent length!");
-    seq=l.seq; c=l.c; e=l.e; psl=l.psl; return *this;
+    skew=l.skew; seq=l.seq; c=l.c; tail=l.tail; peak=l.peak; e=l.e; psl=l.psl; return *this;
 }
 
-void LABS::random(mt19937 & rand){
-    for(size_t i=0; i<L; i++){
-        if(rand()%2) seq[i] = p;
-        else seq[i] = n;
+template<size_t N>
+void LABS<N>::random(mt19937 & rand){
+    // En klic generatorja da 32 nakljucnih elementov.
+    for(size_t i=0; i<moves(); i+=32){
+        const uint32_t w = rand();
+        for(size_t j=i; j<min(moves(), i+32); j++) seq[j] = (w>>(j-i))&1 ? p : n;
     }
+    mirror();
 }
 
-void LABS::evaluate_e(){
-    e = 0;
-    for (size_t k=1; k<L; k++) {
-        c[k]=0;
-        for (size_t i=0; i<=L-k-1; i++) c[k] += seq[i]*seq[i+k];
-        e += c[k]*c[k];
+// Enakomerno krizanje: vsak prosti element vzamemo iz tega ali iz l.
+template<size_t N>
+void LABS<N>::crossover(const LABS & l, mt19937 & rand){
+    for(size_t i=0; i<moves(); i+=32){
+        const uint32_t w = rand();
+        for(size_t j=i; j<min(moves(), i+32); j++) if((w>>(j-i))&1) seq[j] = l.seq[j];
     }
+    mirror();
 }
 
-void LABS::evaluate_psl(){
-    psl = 0;
-    for (size_t k=1; k<L; k++) {
-        c[k]=0;
+// Pri skew-simetricnem zaporedju iz prostih elementov dopolni zrcalne.
+template<size_t N>
+void LABS<N>::mirror(){
+    if(!skew) return;
+    const size_t m = moves();
+    for(size_t i=0; i+1<m; i++) seq[L-1-i] = (m-1-i)%2 ? (value)(-seq[i]) : seq[i];
+}
+
+// Delni zagon: k nakljucnih potez, vsaka stane O(L) namesto O(L^2) za evaluate_e.
+template<size_t N>
+void LABS<N>::perturb_e(const size_t k, mt19937 & rand){
+    for(size_t t=0; t<k; t++){
+        const size_t i = rand()%moves();
+        update_e(i, neighbor_e(i));
+    }
+}
+
+template<size_t N>
+void LABS<N>::perturb_psl(const size_t k, mt19937 & rand){
+    for(size_t t=0; t<k; t++){
+        const size_t i = rand()%moves();
+        update_psl(i, neighbor_psl(i));
+    }
+}
+
+// Vsi c[k] iz zaporedja; v skew nacinu le sodi, lihi so 0.
+template<size_t N>
+void LABS<N>::correlate(){
+    const size_t step = skew ? 2 : 1;
+    for (size_t k=1; k<L; k++) c[k]=0;
+    for (size_t k=step; k<L; k+=step) {
         for (size_t i=0; i<=L-k-1; i++) c[k] += seq[i]*seq[i+k];
-        if(abs(c[k]) > psl) psl = abs(c[k]);
     }
+    #ifndef NDEBUG
+    check_skew();
+    #endif
+}
+
+template<size_t N>
+void LABS<N>::evaluate_e(){
+    correlate();
+    tail[L] = 0;
+    for (size_t k=L-1; k>=1; k--) tail[k] = tail[k+1] + c[k]*c[k];
+    e = tail[1];
+}
+
+template<size_t N>
+void LABS<N>::evaluate_psl(){
+    correlate();
+    peak[L] = 0;
+    for (size_t k=L-1; k>=1; k--) peak[k] = max(peak[k+1], abs(c[k]));
+    psl = peak[1];
+}
+
+// E, PSL (in s tem F) iz enega izracuna c[]; po njem veljata tail in peak.
+template<size_t N>
+void LABS<N>::evaluate(){
+    correlate();
+    tail[L] = 0;
+    peak[L] = 0;
+    for (size_t k=L-1; k>=1; k--){
+        tail[k] = tail[k+1] + c[k]*c[k];
+        peak[k] = max(peak[k+1], abs(c[k]));
+    }
+    e = tail[1];
+    psl = peak[1];
+}
+
+// Preveri, da so lihi c[k] res 0, ker jih skew-simetricne funkcije ne racunajo.
+template<size_t N>
+void LABS<N>::check_skew() const{
+    if(!skew) return;
+    for (size_t k=1; k<L; k+=2){
+        int ck = 0;
+        for (size_t i=0; i<=L-k-1; i++) ck += seq[i]*seq[i+k];
+        if(ck) throw string("Sequence is not skew-symmetric!");
+    }
+}
+
+// Za koliko se zmanjsa c[k]/2 (k sod), ce hkrati zamenjamo s[i] in zrcalni s[m], m = L-1-i.
+// Pri sodem k je s[m]*(s[m+k] + s[m-k]) = s[i]*(s[i-k] + s[i+k]), zato zrcalni element
+// le podvoji prispevek s[i]. Produkt s[i]*s[m] pri k = m-i ostane enak.
+template<size_t N>
+int LABS<N>::skew_delta(const size_t i, const size_t k) const{
+    const size_t m = L-1-i;
+    int d = 0;
+    if(i+k<L) d += seq[i]*seq[k+i];
+    if(k<=i) d += seq[i-k]*seq[i];
+    if(m != i){
+        d *= 2;
+        if(k == m-i) d -= 2*seq[i]*seq[m];
+    }
+    return d;
 }
 
-int LABS::neighbor_e(const size_t i) const{
+template<size_t N>
+int LABS<N>::neighbor_e(const size_t i) const{
     int e = 0, ck;
     const size_t lmt = std::max(L-i,i+1);
     size_t k=1;
+    if(skew){
+        for(k=2; k<lmt; k+=2){
+            ck = c[k] - 2*skew_delta(i,k);
+            e += ck*ck;
+        }
+        return e + tail[min(k,L)];
+    }
     for(;k<lmt; k++) {
         ck = c[k];
         if(i+k<L) ck -= 2*seq[i]*seq[k+i];
         if(k<=i) ck -= 2*seq[i-k]*seq[i];
         e += ck*ck;
     }
-    for (; k<L; k++) e += c[k]*c[k];
-    return e;
+    return e + tail[k];
+}
+
+// Energije vseh L sosedov v enem prehodu. Po zamenjavi s[i] je
+// c'[k] = c[k] - 2*s[i]*d[k], d[k] = s[i+k] + s[i-k], zato je
+// E' = E + 4*(sum d[k]^2 - s[i]*sum c[k]*d[k]). Elementi izven zaporedja so 0,
+// tako da notranja zanka nima pogojev.
+template<size_t N>
+void LABS<N>::neighborhood_e(ints & ne, const size_t from, const size_t to) const{
+    if(skew) return skew_neighborhood_e(ne, from, to);
+    Buffer<int,3*N> f(3*L,0), b(3*L,0); // f[L+j] = s[j], b[L+j] = s[L-1-j]
+    for(size_t j=0; j<L; j++){
+        f[L+j] = seq[j];
+        b[2*L-1-j] = seq[j];
+    }
+    for(size_t i=from; i<to; i++){
+        const int *fi = &f[L+i], *bi = &b[2*L-1-i]; // fi[k] = s[i+k], bi[k] = s[i-k]
+        int cd = 0, dd = 0;
+        for(size_t k=1; k<L; k++){
+            const int d = fi[k] + bi[k];
+            cd += c[k]*d;
+            dd += d*d;
+        }
+        ne[i] = e + 4*(dd - seq[i]*cd);
+        #ifndef NDEBUG
+        if(ne[i] != neighbor_e(i)) throw string("Wrong neighborhood E!");
+        #endif
+    }
+}
+
+// Enako kot neighborhood_e, le da tecemo po sodih k in je d[k] zaradi zrcalnega
+// elementa podvojen (glej skew_delta). Popravek za s[i]*s[m] pristejemo po zanki.
+template<size_t N>
+void LABS<N>::skew_neighborhood_e(ints & ne, const size_t from, const size_t to) const{
+    Buffer<int,3*N> f(3*L,0), b(3*L,0);
+    for(size_t j=0; j<L; j++){
+        f[L+j] = seq[j];
+        b[2*L-1-j] = seq[j];
+    }
+    for(size_t i=from; i<to; i++){
+        const size_t m = L-1-i;
+        const int w = m != i ? 2 : 1;
+        const int *fi = &f[L+i], *bi = &b[2*L-1-i];
+        int cd = 0, dd = 0;
+        for(size_t k=2; k<L; k+=2){
+            const int d = w*(fi[k] + bi[k]);
+            cd += c[k]*d;
+            dd += d*d;
+        }
+        ne[i] = e + 4*(dd - seq[i]*cd);
+        if(m != i){
+            const size_t k = m-i;
+            const int d = seq[i]*w*(fi[k] + bi[k]), x = 2*seq[i]*seq[m];
+            ne[i] += 4*(x*x - 2*x*d + c[k]*x);
+        }
+        #ifndef NDEBUG
+        if(ne[i] != neighbor_e(i)) throw string("Wrong neighborhood E!");
+        #endif
+    }
 }
 
-int LABS::neighbor_psl(const size_t i) const{
+template<size_t N>
+int LABS<N>::neighbor_psl(const size_t i) const{
     int psl = 0, ck;
     const size_t lmt = max(L-i,i+1);
     size_t k=1;
+    if(skew){
+        for(k=2; k<lmt; k+=2){
+            ck = c[k] - 2*skew_delta(i,k);
+            if(abs(ck) > psl) psl = abs(ck);
+        }
+        return max(psl, peak[min(k,L)]);
+    }
     for(; k<lmt; k++) {
         ck = c[k];
         if(i+k<L) ck -= 2*seq[i]*seq[k+i];
         if(k<=i) ck -= 2*seq[i-k]*seq[i];
         if(abs(ck) > psl) psl = abs(ck);
     }
-    for (size_t k=1; k<L; k++){
-        if(abs(c[k]) > psl) psl = abs(c[k]);
-    }
-    return psl;
+    return max(psl, peak[k]);
 }
 
-void LABS::update_e(const size_t i, const int e){
+// E in PSL soseda v enem prehodu po zamikih; potrebuje veljavna tail in peak.
+template<size_t N>
+void LABS<N>::neighbor(const size_t i, int & e, int & psl) const{
     const size_t lmt = max(L-i,i+1);
+    int ck;
     size_t k=1;
-    for (;k<lmt; k++){
+    e = psl = 0;
+    if(skew){
+        for(k=2; k<lmt; k+=2){
+            ck = c[k] - 2*skew_delta(i,k);
+            e += ck*ck;
+            psl = max(psl, abs(ck));
+        }
+    }
+    else{
+        const int si = 2*seq[i];
+        for(; k<min(L-i,i+1); k++){
+            ck = c[k] - si*(seq[k+i] + seq[i-k]);
+            e += ck*ck;
+            psl = max(psl, abs(ck));
+        }
+        for(; k<L-i; k++){
+            ck = c[k] - si*seq[k+i];
+            e += ck*ck;
+            psl = max(psl, abs(ck));
+        }
+        for(; k<=i; k++){
+            ck = c[k] - si*seq[i-k];
+            e += ck*ck;
+            psl = max(psl, abs(ck));
+        }
+    }
+    e += tail[lmt];
+    psl = max(psl, peak[lmt]);
+}
+
+// E in PSL vseh sosedov v enem prehodu. PSL potrebuje posamezne c'[k] = c[k] - 2*s[i]*d[k],
+// zato jih racunamo eksplicitno na razsirjenih poljih kot v neighborhood_e; za k >= lmt
+// vzamemo tail in peak. V skew nacinu je d[k] podvojen, pri k = m-i pa produkt s[i]*s[m]
+// ostane enak (glej skew_delta).
+template<size_t N>
+void LABS<N>::neighborhood(ints & ne, ints & np) const{
+    Buffer<int,3*N> f(3*L,0), b(3*L,0); // f[L+j] = s[j], b[L+j] = s[L-1-j]
+    for(size_t j=0; j<L; j++){
+        f[L+j] = seq[j];
+        b[2*L-1-j] = seq[j];
+    }
+    for(size_t i=0; i<moves(); i++){
+        const size_t lmt = max(L-i,i+1), m = L-1-i;
+        const int *fi = &f[L+i], *bi = &b[2*L-1-i];
+        int e = 0, psl = 0;
+        if(skew){
+            const int si = (m != i ? 4 : 2)*seq[i], fix = 4*seq[i]*seq[m];
+            const size_t ks = m != i ? m-i : L; // zamik z nespremenjenim produktom
+            for(size_t k=2; k<lmt; k+=2){
+                const int ck = c[k] - si*(fi[k] + bi[k]) + (k == ks ? fix : 0);
+                e += ck*ck;
+                psl = max(psl, abs(ck));
+            }
+        }
+        else{
+            const int si = 2*seq[i];
+            for(size_t k=1; k<lmt; k++){
+                const int ck = c[k] - si*(fi[k] + bi[k]);
+                e += ck*ck;
+                psl = max(psl, abs(ck));
+            }
+        }
+        ne[i] = e + tail[lmt];
+        np[i] = max(psl, peak[lmt]);
+        #ifndef NDEBUG
+        if(ne[i] != neighbor_e(i)) throw string("Wrong neighborhood E!");
+        if(np[i] != neighbor_psl(i)) throw string("Wrong neighborhood PSL!");
+        #endif
+    }
+}
+
+// Zamenja s[i] (v skew nacinu se zrcalni element) in popravi c[k]. Vrne lmt;
+// c[k] za k >= lmt ostanejo enaki, zato je treba tail in peak popraviti le pod lmt.
+template<size_t N>
+size_t LABS<N>::flip(const size_t i){
+    const size_t lmt = max(L-i,i+1);
+    if(skew) for (size_t k=2; k<lmt; k+=2) c[k] -= 2*skew_delta(i,k);
+    else for (size_t k=1; k<lmt; k++){
         int ck = c[k];
         if(i+k<L) ck -= 2*seq[i]*seq[k+i];
         if(k<=i) ck -= 2*seq[i-k]*seq[i];
         c[k] = ck;
     }
-    this->e = e;
     seq[i] = (value)(-seq[i]);
+    if(skew && L-1-i != i) seq[L-1-i] = (value)(-seq[L-1-i]);
+    return lmt;
+}
+
+template<size_t N>
+void LABS<N>::update_e(const size_t i, const int e){
+    const size_t lmt = flip(i);
+    for (size_t k=lmt-1; k>=1; k--) tail[k] = tail[k+1] + c[k]*c[k];
+    this->e = e;
     #ifndef NDEBUG
     int update_e = e;
+    auto update_tail = tail;
     evaluate_e();
-    if(e != update_e) throw string("Wrong E!");
+    if(e != update_e || tail != update_tail) throw string("Wrong E!");
     #endif
 }
 
-void LABS::update_psl(const size_t i, const int psl){
-    const size_t lmt = max(L-i,i+1);
-    size_t k=1;
-    int ck;
-    for (; k<lmt; k++){
-        ck = c[k];
-        if(i+k<L) ck -= 2*seq[i]*seq[k+i];
-        if(k<=i) ck -= 2*seq[i-k]*seq[i];
-        c[k] = ck;
-    }
+template<size_t N>
+void LABS<N>::update_psl(const size_t i, const int psl){
+    const size_t lmt = flip(i);
+    for (size_t k=lmt-1; k>=1; k--) peak[k] = max(peak[k+1], abs(c[k]));
     this->psl = psl;
-    seq[i] = (value)(-seq[i]);
     #ifndef NDEBUG
     int update_psl = psl;
+    auto update_peak = peak;
     evaluate_psl();
-    if(psl != update_psl) throw string("Wrong PSL!");
+    if(psl != update_psl || peak != update_peak) throw string("Wrong PSL!");
+    #endif
+}
+
+// Ena zamenjava, po kateri veljata tako tail kot peak (za hkratno iskanje po E in PSL).
+template<size_t N>
+void LABS<N>::update(const size_t i, const int e, const int psl){
+    const size_t lmt = flip(i);
+    for (size_t k=lmt-1; k>=1; k--){
+        tail[k] = tail[k+1] + c[k]*c[k];
+        peak[k] = max(peak[k+1], abs(c[k]));
+    }
+    this->e = e;
+    this->psl = psl;
+    #ifndef NDEBUG
+    int update_e = e, update_psl = psl;
+    auto update_tail = tail;
+    auto update_peak = peak;
+    evaluate();
+    if(e != update_e || tail != update_tail) throw string("Wrong E!");
+    if(psl != update_psl || peak != update_peak) throw string("Wrong PSL!");
     #endif
 }
 
-LABS LABS::steepest_descent_search_e(const size_t seed, const size_t n, const size_t L){
-    LABS current(L), best(L);
+template<size_t N>
+LABS<N> LABS<N>::steepest_descent_search_e(const size_t seed, const size_t n, const size_t L, const bool skew,
+                                                const Restart::policy policy, const size_t perturb, ThreadPool * pool){
+    LABS current(L,skew), best(L,skew);
     mt19937 rand(seed);
     best.random(rand);
     best.evaluate_e();
     current = best;
-    const size_t stepLmt = 8*L;
-    size_t nfes=0, best_neighbor, step=0;
-    int best_neighbor_e, e;
+    Restart restart(policy, policy == Restart::fixed ? 8*L : L, perturb);
+    size_t nfes=0, best_neighbor=0;
+    int best_neighbor_e, run_e = current.get_e(); // run_e je najboljsa E trenutnega zagona
+    ints ne(L,0);
+    // Z nitmi vsaka oceni svoj del sosedov in vrne najboljsega. Zdruzimo jih po vrsti
+    // niti, zato je izbira enaka kot pri zaporednem min_element.
+    vector<Local> local(pool ? pool->size() : 0);
+    const function<void(size_t)> task = [&](const size_t w){
+        const size_t M = current.moves(), from = M*w/local.size(), to = M*(w+1)/local.size();
+        current.neighborhood_e(ne, from, to);
+        local[w].value = numeric_limits<int>::max();
+        for(size_t i=from; i<to; i++){
+            if(ne[i] < local[w].value){
+                local[w].i = i;
+                local[w].value = ne[i];
+            }
+        }
+    };
     while(nfes < n){
-        best_neighbor_e = numeric_limits<int>::max();
-        for(size_t i=0; i<L; i++){
-            e = current.neighbor_e(i);
-            if(e < best_neighbor_e){
-                best_neighbor = i;
-                best_neighbor_e = e;
+        if(pool){
+            pool->run(task);
+            best_neighbor_e = numeric_limits<int>::max();
+            for(const Local & l: local){
+                if(l.value < best_neighbor_e){
+                    best_neighbor = l.i;
+                    best_neighbor_e = l.value;
+                }
             }
         }
-        nfes+=L;
+        else{
+            current.neighborhood_e(ne);
+            best_neighbor = min_element(ne.begin(), ne.begin()+current.moves()) - ne.begin();
+            best_neighbor_e = ne[best_neighbor];
+        }
+        nfes+=current.moves();
         current.update_e(best_neighbor,best_neighbor_e);
         if(current.get_e() < best.get_e()) best = current;
-        if(step >= stepLmt){
-            current.random(rand);
-            current.evaluate_e();
-            nfes++;
-            step = 0;
-            if(current.get_psl() < best.get_psl()) best = current;
+        const bool improved = current.get_e() < run_e;
+        if(improved) run_e = current.get_e();
+        if(restart.step(improved)){
+            if(restart.get_perturb()){
+                current = best;
+                current.perturb_e(restart.get_perturb(), rand);
+                nfes += restart.get_perturb();
+            }
+            else{
+                current.random(rand);
+                current.evaluate_e();
+                nfes++;
+            }
+            run_e = current.get_e();
+            if(current.get_e() < best.get_e()) best = current;
         }
-        step++;
     }
     return best;
 }
 
-LABS LABS::steepest_descent_search_psl(const size_t seed, const size_t n, const size_t L){
-    LABS current(L), best(L);
+template<size_t N>
+LABS<N> LABS<N>::steepest_descent_search_psl(const size_t seed, const size_t n, const size_t L, const bool skew,
+                                                const Restart::policy policy, const size_t perturb, ThreadPool * pool){
+    LABS current(L,skew), best(L,skew);
     mt19937 rand(seed);
     best.random(rand);
     best.evaluate_psl();
     current = best;
-    const size_t stepLmt = 8*L;
-    size_t nfes=0, best_neighbor, step=0;
-    int best_neighbor_psl, psl;
+    Restart restart(policy, policy == Restart::fixed ? 8*L : L, perturb);
+    size_t nfes=0, best_neighbor=0;
+    int best_neighbor_psl, psl, run_psl = current.get_psl();
+    vector<Local> local(pool ? pool->size() : 0);
+    const function<void(size_t)> task = [&](const size_t w){
+        const size_t M = current.moves(), from = M*w/local.size(), to = M*(w+1)/local.size();
+        local[w].value = numeric_limits<int>::max();
+        for(size_t i=from; i<to; i++){
+            const int v = current.neighbor_psl(i);
+            if(v < local[w].value){
+                local[w].i = i;
+                local[w].value = v;
+            }
+        }
+    };
     while(nfes < n){
         best_neighbor_psl = numeric_limits<int>::max();
-        for(size_t i=0; i<L; i++){
+        if(pool){
+            pool->run(task);
+            for(const Local & l: local){
+                if(l.value < best_neighbor_psl){
+                    best_neighbor = l.i;
+                    best_neighbor_psl = l.value;
+                }
+            }
+        }
+        else for(size_t i=0; i<current.moves(); i++){
             psl = current.neighbor_psl(i);
             if(psl < best_neighbor_psl){
                 best_neighbor = i;
                 best_neighbor_psl = psl;
             }
         }
-        nfes+=L;
+        nfes+=current.moves();
         current.update_psl(best_neighbor,best_neighbor_psl);
         if(current.get_psl() < best.get_psl()) best = current;
-        if(step >= stepLmt){
-            current.random(rand);
-            current.evaluate_psl();
-            nfes++;
-            step = 0;
+        const bool improved = current.get_psl() < run_psl;
+        if(improved) run_psl = current.get_psl();
+        if(restart.step(improved)){
+            if(restart.get_perturb()){
+                current = best;
+                current.perturb_psl(restart.get_perturb(), rand);
+                nfes += restart.get_perturb();
+            }
+            else{
+                current.random(rand);
+                current.evaluate_psl();
+                nfes++;
+            }
+            run_psl = current.get_psl();
             if(current.get_psl() < best.get_psl()) best = current;
         }
-        step++;
     }
     return best;
 }
 
-int main(int argc, char *argv[]){
-    try{
-        if(argc < 4) throw string("Three arguments are required!");
+// Skupni arhiv elitnih zaporedij sodelujocih niti, brez zaklepanja. Stanje reze je en
+// atomaren 64-bitni par (verzija, vrednost). Nit zasede najslabso rezo s CAS na stanje
+// (liha verzija), zapise zaporedje in njegov prstni odtis ter objavi novo vrednost s
+// sodo verzijo. Bralec kopira zaporedje in ga sprejme le, ce se stanje med kopiranjem
+// ni spremenilo.
+template<size_t N>
+class ElitePool{
+public:
+    ElitePool(const size_t slots, const size_t L): slots(slots), L(L), state(slots), print(slots), seq(slots*L) {
+        for(atomic<uint64_t> & s: state) s.store(pack(0, numeric_limits<int>::max()));
+        for(atomic<uint64_t> & f: print) f.store(0);
+    }
+    bool publish(const LABS<N> & l, const int v);
+    bool sample(LABS<N> & l, mt19937 & rand) const;
 
-        const size_t seed =atoi(argv[1]), n = atoi(argv[2]), L = atoi(argv[3]);
+private:
+    static uint64_t pack(const uint64_t version, const int v){ return version<<32 | (uint32_t)v; }
+    static int energy(const uint64_t s){ return (int)(uint32_t)s; }
+    static bool busy(const uint64_t s){ return (s>>32)%2; }
+    bool read(const size_t slot, LABS<N> & l) const;
+    const size_t slots, L;
+    vector<atomic<uint64_t>> state;
+    vector<atomic<uint64_t>> print; // prstni odtis zaporedja v rezi
+    vector<atomic<signed char>> seq;
+};
+
+// Zaporedje, ki je ze v arhivu, zavrnemo, da ga ne napolni ena resitev. Primerjamo
+// prstne odtise, ne vrednosti, saj imajo pri PSL skoraj vse elite enako vrednost.
+template<size_t N>
+bool ElitePool<N>::publish(const LABS<N> & l, const int v){
+    const uint64_t fp = l.fingerprint();
+    while(true){
+        size_t w = 0;
+        uint64_t ws = state[0].load(memory_order_relaxed);
+        for(size_t i=0; i<slots; i++){
+            const uint64_t s = state[i].load(memory_order_acquire);
+            if(energy(s) == v && !busy(s)){
+                const uint64_t f = print[i].load(memory_order_relaxed);
+                atomic_thread_fence(memory_order_acquire);
+                if(f == fp && state[i].load(memory_order_relaxed) == s) return false;
+            }
+            if(energy(s) > energy(ws)){
+                w = i;
+                ws = s;
+            }
+        }
+        if(v >= energy(ws)) return false;
+        if(busy(ws)) continue;
+        if(!state[w].compare_exchange_weak(ws, pack((ws>>32)+1, energy(ws)), memory_order_acquire)) continue;
+        atomic_thread_fence(memory_order_release);
+        for(size_t i=0; i<L; i++) seq[w*L+i].store(l.seq[i], memory_order_relaxed);
+        print[w].store(fp, memory_order_relaxed);
+        state[w].store(pack((ws>>32)+2, v), memory_order_release);
+        return true;
+    }
+}
+
+template<size_t N>
+bool ElitePool<N>::read(const size_t slot, LABS<N> & l) const{
+    const uint64_t s = state[slot].load(memory_order_acquire);
+    if(busy(s) || energy(s) == numeric_limits<int>::max()) return false;
+    for(size_t i=0; i<L; i++) l.seq[i] = (typename LABS<N>::value)seq[slot*L+i].load(memory_order_relaxed);
+    atomic_thread_fence(memory_order_acquire);
+    return state[slot].load(memory_order_relaxed) == s;
+}
+
+// Zaporedje nakljucne zasedene reze; l je treba nato ponovno oceniti.
+template<size_t N>
+bool ElitePool<N>::sample(LABS<N> & l, mt19937 & rand) const{
+    for(size_t t=0; t<2*slots; t++){
+        if(read(rand()%slots, l)) return true;
+    }
+    return false;
+}
+
+// Zagoni kot neodvisna opravila na vseh nitih bazena. Opravilo t zacne v nakljucnem
+// zaporedju s semenom (seed, t) in tece kot t-ti zagon politike. Dolzine opravil se
+// mocno razlikujejo, zato jih delimo krozno in razporejamo s krajo dela. Proracun NFE in najboljso
+// vrednost hranimo v atomarnih spremenljivkah; nit kopira zaporedje le, ko izboljsa
+// skupno najboljso vrednost, na koncu pa izberemo najboljse med nitmi.
+// Z elitnim arhivom niti sodelujejo: vsako opravilo objavi najboljse zaporedje svojega
+// zagona, opravila po prvem krogu pa izmenicno zacnejo nakljucno, iz elite z nekaj
+// nakljucnimi zamenjavami ali iz krizanja dveh elit. Ker opravila delimo krozno, nit
+// opravilo t >= T vzame sele po svojem opravilu iz prvega kroga, ki je ze objavilo
+// zaporedje; ce je arhiv vseeno prazen, zacnemo nakljucno.
+template<size_t N>
+LABS<N> LABS<N>::steepest_descent_tasks(const size_t seed, const size_t n, const size_t L, const bool skew,
+                                        const Restart::policy policy, ThreadPool & pool, const bool psl,
+                                        ElitePool<N> * elites){
+    const size_t unit = policy == Restart::fixed ? 8*L : L, M = skew ? (L+1)/2 : L;
+    // Le toliko opravil, kolikor zagonov zaporedno iskanje doseze s proracunom n
+    WorkStealing scheduler(pool.size(), Restart(policy, unit, 0).runs(n/M));
+    atomic<size_t> nfes(0);
+    atomic<int> incumbent(numeric_limits<int>::max());
+    vector<LABS> bests(pool.size(), LABS(L,skew));
+    pool.run([&](const size_t w){
+        LABS current(L,skew), run(L,skew), other(L,skew);
+        ints ne(L,0);
+        const auto value = [&](){ return psl ? current.get_psl() : current.get_e(); };
+        const auto publish = [&](){
+            int v = incumbent.load(memory_order_relaxed);
+            while(value() < v){
+                if(incumbent.compare_exchange_weak(v, value())){
+                    bests[w] = current;
+                    break;
+                }
+            }
+        };
+        size_t task;
+        while(nfes.load(memory_order_relaxed) < n && scheduler.pop(w, task)){
+            seed_seq sseq{seed, task};
+            mt19937 rand(sseq);
+            const size_t start = elites && task >= pool.size() ? task%3 : 0;
+            if(start == 1 && elites->sample(current, rand)){
+                if(psl) current.evaluate_psl();
+                else current.evaluate_e();
+                const size_t k = max(M/8, (size_t)1);
+                if(psl) current.perturb_psl(k, rand);
+                else current.perturb_e(k, rand);
+                nfes += k;
+            }
+            else{
+                if(start == 2 && elites->sample(current, rand) && elites->sample(other, rand)) current.crossover(other, rand);
+                else current.random(rand);
+                if(psl) current.evaluate_psl();
+                else current.evaluate_e();
+            }
+            nfes++;
+            publish();
+            run = current;
+            Restart restart(policy, unit, 0);
+            restart.skip(task);
+            int run_best = value();
+            bool improved;
+            do{
+                if(nfes.fetch_add(M, memory_order_relaxed) >= n) break;
+                size_t best_neighbor = 0;
+                if(psl){
+                    int best_neighbor_psl = numeric_limits<int>::max();
+                    for(size_t i=0; i<M; i++){
+                        const int v = current.neighbor_psl(i);
+                        if(v < best_neighbor_psl){
+                            best_neighbor = i;
+                            best_neighbor_psl = v;
+                        }
+                    }
+                    current.update_psl(best_neighbor,best_neighbor_psl);
+                }
+                else{
+                    current.neighborhood_e(ne);
+                    best_neighbor = min_element(ne.begin(), ne.begin()+M) - ne.begin();
+                    current.update_e(best_neighbor,ne[best_neighbor]);
+                }
+                publish();
+                improved = value() < run_best;
+                if(improved){
+                    run_best = value();
+                    if(elites) run = current;
+                }
+            } while(!restart.step(improved));
+            if(elites) elites->publish(run, run_best);
+        }
+    });
+    size_t b = 0;
+    for(size_t w=1; w<bests.size(); w++){
+        if(psl ? bests[w].get_psl() < bests[b].get_psl() : bests[w].get_e() < bests[b].get_e()) b = w;
+    }
+    return bests[b];
+}
+
+// Hkratno iskanje po E in PSL z enim proracunom. Za vsakega soseda izracunamo
+// obe vrednosti in ga ponudimo arhivu. Korak vodi E ali PSL (drugo odloci ob
+// enakosti), ob vsakem ponovnem zagonu pa vodilni kriterij zamenjamo.
+template<size_t N>
+Pareto<N> LABS<N>::steepest_descent_search_pareto(const size_t seed, const size_t n, const size_t L, const bool skew,
+                                                  const Restart::policy policy, const size_t perturb){
+    LABS current(L,skew);
+    Pareto<N> archive;
+    mt19937 rand(seed);
+    current.random(rand);
+    current.evaluate();
+    archive.insert(current);
+    Restart restart(policy, policy == Restart::fixed ? 8*L : L, perturb);
+    const size_t M = current.moves();
+    size_t nfes=0, best_neighbor=0;
+    bool by_psl = false;
+    int run_best = current.get_e(); // najboljsa vrednost vodilnega kriterija v tem zagonu
+    ints ne(L,0), np(L,0);
+    auto better = [&](const size_t i, const size_t j){
+        if(by_psl) return np[i] < np[j] || (np[i] == np[j] && ne[i] < ne[j]);
+        return ne[i] < ne[j] || (ne[i] == ne[j] && np[i] < np[j]);
+    };
+    while(nfes < n){
+        current.neighborhood(ne, np);
+        nfes+=M;
+        best_neighbor = 0;
+        for(size_t i=0; i<M; i++){
+            if(!archive.dominated(ne[i], np[i])){
+                LABS neighbor = current;
+                neighbor.update(i, ne[i], np[i]);
+                archive.insert(neighbor);
+            }
+            if(better(i, best_neighbor)) best_neighbor = i;
+        }
+        current.update(best_neighbor, ne[best_neighbor], np[best_neighbor]);
+        const int value = by_psl ? current.get_psl() : current.get_e();
+        const bool improved = value < run_best;
+        if(improved) run_best = value;
+        if(restart.step(improved)){
+            by_psl = !by_psl;
+            if(restart.get_perturb()){
+                current = by_psl ? archive.best_psl() : archive.best_e();
+                for(size_t t=0; t<restart.get_perturb(); t++){
+                    const size_t i = rand()%M;
+                    int e, psl;
+                    current.neighbor(i, e, psl);
+                    current.update(i, e, psl);
+                }
+                nfes += restart.get_perturb();
+            }
+            else{
+                current.random(rand);
+                current.evaluate();
+                nfes++;
+            }
+            archive.insert(current);
+            run_best = by_psl ? current.get_psl() : current.get_e();
+        }
+    }
+    return archive;
+}
+
+template<size_t N>
+void run(const size_t seed, const size_t n, const size_t L, const bool skew, const Restart::policy policy, const size_t perturb,
+         const bool pareto, const size_t threads, const bool tasks, const size_t elite){
+    if(pareto){
         cout<<"Searching ..."<<endl;
         auto start = system_clock::now();
-        LABS best = LABS::steepest_descent_search_e(seed,n,L);
+        Pareto<N> archive = LABS<N>::steepest_descent_search_pareto(seed,n,L,skew,policy,perturb);
         auto end = system_clock::now();
         auto elapsed = duration_cast<milliseconds>(end - start);
-        cout<<"E: "<<best.get_e()<<" F: "<<best.get_mf();
+        cout<<"E: "<<archive.best_e().get_e()<<" F: "<<archive.best_e().get_mf();
         cout<<" speed: "<<n/(elapsed.count()/1000.0)<<" eval/sec"<<endl;
+        cout<<"PSL: "<<archive.best_psl().get_psl()<<endl;
+        for(const LABS<N> & m: archive.get_front()) cout<<"Pareto: PSL "<<m.get_psl()<<" E "<<m.get_e()<<endl;
+        return;
+    }
+    unique_ptr<ThreadPool> pool(threads > 1 || tasks ? new ThreadPool(threads) : nullptr);
+    unique_ptr<ElitePool<N>> elites(elite ? new ElitePool<N>(elite, L) : nullptr);
+    cout<<"Searching ..."<<endl;
+    auto start = system_clock::now();
+    LABS<N> best = tasks ? LABS<N>::steepest_descent_tasks(seed,n,L,skew,policy,*pool,false,elites.get()) :
+                           LABS<N>::steepest_descent_search_e(seed,n,L,skew,policy,perturb,pool.get());
+    auto end = system_clock::now();
+    auto elapsed = duration_cast<milliseconds>(end - start);
+    cout<<"E: "<<best.get_e()<<" F: "<<best.get_mf();
+    cout<<" speed: "<<n/(elapsed.count()/1000.0)<<" eval/sec"<<endl;
 
-        cout<<"Searching ..."<<endl;
-        start = system_clock::now();
-        best = LABS::steepest_descent_search_psl(seed,n,L);
-        end = system_clock::now();
-        elapsed = duration_cast<milliseconds>(end - start);
-        cout<<"PSL: "<<best.get_psl();
-        cout<<" speed: "<<n/(elapsed.count()/1000.0)<<" eval/sec"<<endl;
+    cout<<"Searching ..."<<endl;
+    start = system_clock::now();
+    if(elite) elites.reset(new ElitePool<N>(elite, L));
+    best = tasks ? LABS<N>::steepest_descent_tasks(seed,n,L,skew,policy,*pool,true,elites.get()) :
+                   LABS<N>::steepest_descent_search_psl(seed,n,L,skew,policy,perturb,pool.get());
+    end = system_clock::now();
+    elapsed = duration_cast<milliseconds>(end - start);
+    cout<<"PSL: "<<best.get_psl();
+    cout<<" speed: "<<n/(elapsed.count()/1000.0)<<" eval/sec"<<endl;
+}
+
+int main(int argc, char *argv[]){
+    try{
+        if(argc < 4) throw string("Three arguments are required!");
+
+        const size_t seed =atoi(argv[1]), n = atoi(argv[2]), L = atoi(argv[3]);
+        // Dodatni argumenti: "skew" omeji iskanje na skew-simetricna zaporedja lihe dolzine,
+        // "luby", "geometric" ali "stagnation" izbere politiko ponovnih zagonov,
+        // "perturb=k" delni zagon, ki zamenja k elementov najboljse resitve, "pareto"
+        // eno iskanje po E in PSL hkrati, ki izpise se fronto nedominiranih resitev,
+        // "threads=T" oceni sosede vsakega koraka s T nitmi, "tasks" namesto tega
+        // izvaja zagone kot neodvisna opravila na T nitih, "elite=K" pa jih poveze
+        // s skupnim arhivom K elitnih zaporedij.
+        bool skew = false, pareto = false, tasks = false;
+        size_t threads = 1, elite = 0;
+        Restart::policy policy = Restart::fixed;
+        size_t perturb = 0;
+        for(int a=4; a<argc; a++){
+            const string arg = argv[a];
+            if(arg == "skew") skew = true;
+            else if(arg == "pareto") pareto = true;
+            else if(arg == "tasks") tasks = true;
+            else if(arg.compare(0, 6, "elite=") == 0){
+                elite = atoi(arg.c_str()+6);
+                tasks = true;
+            }
+            else if(arg.compare(0, 8, "threads=") == 0) threads = atoi(arg.c_str()+8);
+            else if(arg == "luby") policy = Restart::luby;
+            else if(arg == "geometric") policy = Restart::geometric;
+            else if(arg == "stagnation") policy = Restart::stagnation;
+            else if(arg.compare(0, 8, "perturb=") == 0) perturb = atoi(arg.c_str()+8);
+            else throw string("Unknown argument: ") + arg;
+        }
+        if(threads < 1) throw string("Number of threads must be at least 1!");
+        if(tasks && (perturb || pareto)) throw string("Option tasks cannot be combined with perturb or pareto!");
+        // Pogoste dolzine so prevedene s konstantno dolzino, ostale tecejo z LABS<0>
+        switch(L){
+        case 4: run<4>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 5: run<5>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 6: run<6>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 7: run<7>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 8: run<8>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 9: run<9>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 10: run<10>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 11: run<11>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 12: run<12>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 13: run<13>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 14: run<14>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 15: run<15>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 16: run<16>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 17: run<17>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 18: run<18>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 19: run<19>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 20: run<20>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        case 513: run<513>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite); break;
+        default: run<0>(seed,n,L,skew,policy,perturb,pareto,threads,tasks,elite);
+        }
     }
     catch (string err) {
         cerr<<err<<std::endl;
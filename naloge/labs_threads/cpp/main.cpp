@@ -3,6 +3,8 @@
 #include <chrono>
 #include <vector>
 #include <limits>
+#include <cstdint>
+#include <algorithm>
 #include <thread>
 
 using namespace std;
@@ -18,6 +20,7 @@ public:
     inline double get_mf() const { return (L*L)/(2.0*e); }
     inline int get_e() const { return e; }
     inline int get_psl() const { return psl; }
+    void print(ostream & out) const;
     void random(mt19937 & rand);
     void evaluate_e();
     void evaluate_psl();
@@ -25,6 +28,8 @@ public:
     static LABS search_psl(const size_t seed, const size_t n, const size_t L, const size_t num_threads);
 
 private:
+    static void thread_search_e(const size_t seed, const size_t t, const size_t n, LABS & best);
+    static void thread_search_psl(const size_t seed, const size_t t, const size_t n, LABS & best);
     const size_t L;
     vector<value> seq;
     vector<int> c;
@@ -36,10 +41,15 @@ LABS& LABS::operator=(const LABS & l){
     seq=l.seq; c=l.c; e=l.e; psl=l.psl; return *this;
 }
 
+void LABS::print(ostream & out) const{
+    for(size_t i=0; i<L; i++) out<<(seq[i] == p ? '+' : '-');
+}
+
 void LABS::random(mt19937 & rand){
-    for(size_t i=0; i<L; i++){
-        if(rand()%2) seq[i] = p;
-        else seq[i] = n;
+    // En klic generatorja da 32 nakljucnih elementov.
+    for(size_t i=0; i<L; i+=32){
+        const uint32_t w = rand();
+        for(size_t j=i; j<min(L, i+32); j++) seq[j] = (w>>(j-i))&1 ? p : n;
     }
 }
 
@@ -61,77 +71,94 @@ void LABS::evaluate_psl(){
     }
 }
 
-LABS LABS::search_e(const size_t seed, const size_t n, const size_t L, const size_t num_threads){
-    LABS current(L), best(L);
-    mt19937 rand(seed);
+// Nit t ima svoj delovni LABS in svoj generator; seed_seq iz (seed, t) da
+// neodvisne tokove za razlicne niti. Rezultat zapise le v svoj best.
+void LABS::thread_search_e(const size_t seed, const size_t t, const size_t n, LABS & best){
+    seed_seq sseq{seed, t};
+    mt19937 rand(sseq);
+    LABS current(best.L);
     best.random(rand);
     best.evaluate_e();
-    for(size_t i=0; i<n; i++){
+    for(size_t i=1; i<n; i++){
         current.random(rand);
         current.evaluate_e();
         if(current.get_e() < best.get_e()) best = current;
     }
-    return best;
 }
 
-LABS LABS::search_psl(const size_t seed, const size_t n, const size_t L, const size_t num_threads){
-    LABS current(L), best(L);
-    mt19937 rand(seed);
+void LABS::thread_search_psl(const size_t seed, const size_t t, const size_t n, LABS & best){
+    seed_seq sseq{seed, t};
+    mt19937 rand(sseq);
+    LABS current(best.L);
     best.random(rand);
     best.evaluate_psl();
-    for(size_t i=0; i<n; i++){
+    for(size_t i=1; i<n; i++){
         current.random(rand);
         current.evaluate_psl();
         if(current.get_psl() < best.get_psl()) best = current;
     }
+}
+
+// Proracun n razdelimo enakomerno (prvih n%num_threads niti dobi eno oceno vec),
+// na koncu pa izberemo najboljse zaporedje vseh niti.
+LABS LABS::search_e(const size_t seed, const size_t n, const size_t L, const size_t num_threads){
+    vector<LABS> bests(num_threads, LABS(L));
+    vector<thread> threads;
+    for(size_t t=0; t<num_threads; t++){
+        const size_t nt = n/num_threads + (t < n%num_threads ? 1 : 0);
+        threads.emplace_back(thread_search_e, seed, t, nt, ref(bests[t]));
+    }
+    for(thread & th: threads) th.join();
+    LABS best = bests[0];
+    for(const LABS & b: bests){
+        if(b.get_e() < best.get_e()) best = b;
+    }
+    return best;
+}
+
+LABS LABS::search_psl(const size_t seed, const size_t n, const size_t L, const size_t num_threads){
+    vector<LABS> bests(num_threads, LABS(L));
+    vector<thread> threads;
+    for(size_t t=0; t<num_threads; t++){
+        const size_t nt = n/num_threads + (t < n%num_threads ? 1 : 0);
+        threads.emplace_back(thread_search_psl, seed, t, nt, ref(bests[t]));
+    }
+    for(thread & th: threads) th.join();
+    LABS best = bests[0];
+    for(const LABS & b: bests){
+        if(b.get_psl() < best.get_psl()) best = b;
+    }
     return best;
 }
 
 int main(int argc, char *argv[]){
     try{
-        if(argc < 4) throw string("Four arguments are required!");
+        if(argc < 5) throw string("Four arguments are required!");
 
-        const size_t seed =atoi(argv[1]), n = atoi(argv[2]), D = atoi(argv[3], num_threads = atoi(argv[4]);
+        const size_t seed =atoi(argv[1]), n = atoi(argv[2]), D = atoi(argv[3]), num_threads = atoi(argv[4]);
+        if(num_threads < 1 || num_threads > n) throw string("Number of threads must be between 1 and the number of evaluations!");
 
         cout<<"Searching ..."<<endl;
         auto start = system_clock::now();
-
-        size_t num_threads;
-        std::vector<std::thread> niti;
-
-        for (int i = 0; i < num_threads; i++) {
-            niti.emplace_back(LABS::search_e, seed+i, n, D, num_threads);
-        }
-
-        LABS best = LABS::search_e(seed, n/num_threads, D, num_threads);
+        LABS best = LABS::search_e(seed, n, D, num_threads);
         auto end = system_clock::now();
         auto elapsed = duration_cast<milliseconds>(end - start);
         cout<<"E: "<<best.get_e()<<" F: "<<best.get_mf();
         cout<<" speed: "<<n/(elapsed.count()/1000.0)<<" eval/sec"<<endl;
-
-        for (std::thread& t : niti) {
-            t.join();
+        cout<<"Sequence: ";
+        best.print(cout);
+        cout<<endl;
 
         cout<<"Searching ..."<<endl;
         start = system_clock::now();
-
-        size_t num_threads; // Poljubno število niti
-        std::vector<std::thread> niti;
-
-        for (int i = 0; i < num_threads; i++) {
-            niti.emplace_back(LABS::search_psl, seed + i, n, D, num_threads);
-        }
-
-        best = LABS::search_psl(seed, n / num_threads, D, num_threads);
+        best = LABS::search_psl(seed, n, D, num_threads);
         end = system_clock::now();
         elapsed = duration_cast<milliseconds>(end - start);
         cout<<"PSL: "<<best.get_psl();
         cout<<" speed: "<<n/(elapsed.count()/1000.0)<<" eval/sec"<<endl;
-
-        for (std::thread& t : niti) {
-            t.join();
-        }
-        }
+        cout<<"Sequence: ";
+        best.print(cout);
+        cout<<endl;
     }
     catch (string err) {
         cerr<<err<<std::endl;